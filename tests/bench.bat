@@ -0,0 +1,12 @@
+@echo off
+
+set DEF_FLAGS_COMPILER=-std=c89 -pedantic -Wall -Wextra -Werror -Wvla -Wconversion -Wdouble-promotion -Wsign-conversion -Wuninitialized -Winit-self -Wunused -Wunused-macros -Wunused-local-typedefs
+set DEF_FLAGS_LINKER=
+set SOURCE_NAME=types_bench
+
+cc -s -O2 %DEF_FLAGS_COMPILER% -o %SOURCE_NAME%.exe %SOURCE_NAME%.c %DEF_FLAGS_LINKER%
+cc -s -O2 %DEF_FLAGS_COMPILER% -DTYPES_BRANCHLESS -o %SOURCE_NAME%_branchless.exe %SOURCE_NAME%.c %DEF_FLAGS_LINKER%
+cc -s -O2 %DEF_FLAGS_COMPILER% -DTYPES_SIMD -mssse3 -o %SOURCE_NAME%_simd.exe %SOURCE_NAME%.c %DEF_FLAGS_LINKER%
+%SOURCE_NAME%.exe
+%SOURCE_NAME%_branchless.exe
+%SOURCE_NAME%_simd.exe
@@ -0,0 +1,783 @@
+/* types.h - v0.1 - public domain data structures - nickscha 2025
+
+A C89 standard compliant, single header, nostdlib (no C Standard Library) type I use.
+
+Micro benchmarks for the performance sensitive parts of types.h.
+Build it once without and once with -DTYPES_BRANCHLESS or -DTYPES_SIMD to
+compare the scalar, branchless and SIMD 64-bit operations (see bench.bat).
+
+LICENSE
+
+  Placed in the public domain and also MIT licensed.
+  See end of file for detailed license information.
+
+*/
+#include "../types.h"
+
+#include <stdio.h>  /* printf */
+#include <string.h> /* memcpy, memset as the reference */
+#include <time.h>  /* clock */
+
+#define BENCH_COUNT (1 << 18)
+#define BENCH_ROUNDS 64
+
+/* The inputs are large enough that the branch predictor cannot learn them */
+
+static u64 bench_a[BENCH_COUNT];
+static u64 bench_b[BENCH_COUNT];
+static i64 bench_s[BENCH_COUNT];
+static int bench_n[BENCH_COUNT];
+static u64 bench_r[BENCH_COUNT];
+static b8 bench_m[BENCH_COUNT];
+static u8 bench_bytes[BENCH_COUNT * 4];
+static u8 bench_dst[BENCH_COUNT * 4];
+static u32 bench_u32[BENCH_COUNT];
+static f64 bench_f64[BENCH_COUNT];
+static f32 bench_f32[BENCH_COUNT];
+static f32 bench_f32_r[BENCH_COUNT];
+static u8 bench_stream[STREAMVBYTE_MAX_BYTES(BENCH_COUNT) + U64_LEB128_MAX_BYTES * BENCH_COUNT];
+
+static volatile u32 bench_sink;
+
+static u32 bench_seed = 0x9E3779B9;
+
+static u32 bench_random(void)
+{
+  /* xorshift32 */
+  bench_seed ^= bench_seed << 13;
+  bench_seed ^= bench_seed >> 17;
+  bench_seed ^= bench_seed << 5;
+  return bench_seed;
+}
+
+static void bench_print(char *name, clock_t start, clock_t end, u32 ops)
+{
+  double seconds = (double)(end - start) / (double)CLOCKS_PER_SEC;
+  printf("%-24s %10.3f ms %8.3f ns/op\n", name, seconds * 1000.0, seconds * 1e9 / (double)ops);
+}
+
+static void bench_print_throughput(char *name, clock_t start, clock_t end, double bytes)
+{
+  double seconds = (double)(end - start) / (double)CLOCKS_PER_SEC;
+  printf("%-24s %10.3f ms %8.3f GB/s\n", name, seconds * 1000.0, bytes / seconds / 1e9);
+}
+
+static void bench_init(void)
+{
+  u32 i;
+  for (i = 0; i < BENCH_COUNT; ++i)
+  {
+    u32 high = bench_random();
+    bench_a[i] = u64_make(high, bench_random());
+    /* Half of the pairs share the high word so the low word decides */
+    bench_b[i] = u64_make((bench_random() & 1) ? high : bench_random(), bench_random());
+    bench_s[i] = i64_from_u64(u64_make(bench_random(), bench_random()));
+    bench_n[i] = (int)(bench_random() & 63);
+  }
+  for (i = 0; i < BENCH_COUNT * 4; ++i)
+  {
+    bench_bytes[i] = (u8)bench_random();
+  }
+}
+
+static void bench_arith(void)
+{
+  clock_t start;
+  u32 r;
+  u32 i;
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      bench_a[i] = u64_add(bench_a[i], bench_b[i]);
+    }
+  }
+  bench_print("u64_add", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      bench_a[i] = u64_sub(bench_a[i], bench_b[i]);
+    }
+  }
+  bench_print("u64_sub", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      bench_b[i] = u64_xor(bench_a[i], bench_b[i]);
+    }
+  }
+  bench_print("u64_xor", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      bench_r[i] = u64_mul(bench_a[i], bench_b[i]);
+    }
+    bench_a[r] = bench_r[r];
+  }
+  bench_print("u64_mul", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+}
+
+static void bench_batch(void)
+{
+  clock_t start;
+  u32 r;
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    u64_add_n(bench_r, bench_a, bench_b, BENCH_COUNT);
+    bench_a[r] = bench_r[r]; /* Keeps the compiler from hoisting the call */
+  }
+  bench_print("u64_add_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    u64_mul_n(bench_r, bench_a, bench_b, BENCH_COUNT);
+    bench_a[r] = bench_r[r];
+  }
+  bench_print("u64_mul_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    u64_cmp_lt_n(bench_m, bench_a, bench_b, BENCH_COUNT);
+    bench_a[r] = u64_add_u32(bench_a[r], bench_m[r]);
+  }
+  bench_print("u64_cmp_lt_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  bench_sink = u64_low(bench_r[BENCH_COUNT - 1]) ^ bench_m[BENCH_COUNT - 1];
+}
+
+static void bench_sums(void)
+{
+  clock_t start;
+  u64 sum = u64_make(0, 0);
+  u32 r;
+  u32 i;
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      sum = u64_add(sum, bench_a[i]);
+    }
+  }
+  bench_print("u64_add (sum loop)", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    sum = u64_add(sum, u64_sum_n(bench_a, BENCH_COUNT));
+    bench_a[r] = sum;
+  }
+  bench_print("u64_sum_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    u64_prefix_sum_n(bench_r, bench_a, BENCH_COUNT);
+    bench_a[r] = bench_r[r];
+  }
+  bench_print("u64_prefix_sum_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  bench_sink = u64_low(sum) ^ u64_low(bench_r[BENCH_COUNT - 1]);
+}
+
+static void bench_shifts(void)
+{
+  clock_t start;
+  u64 acc = u64_make(0, 0);
+  i64 sacc = i64_make(0, 0);
+  u32 r;
+  u32 i;
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      acc = u64_xor(acc, u64_shl(bench_a[i], bench_n[i]));
+    }
+  }
+  bench_print("u64_shl", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      acc = u64_xor(acc, u64_shr(bench_a[i], bench_n[i]));
+    }
+  }
+  bench_print("u64_shr", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      sacc = i64_xor(sacc, i64_shr(bench_s[i], bench_n[i]));
+    }
+  }
+  bench_print("i64_shr", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  bench_sink = u64_low(acc) ^ i64_low(sacc);
+}
+
+static void bench_compares(void)
+{
+  clock_t start;
+  u32 count = 0;
+  u32 r;
+  u32 i;
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      count += (u32)u64_lt(bench_a[i], bench_b[i]);
+    }
+  }
+  bench_print("u64_lt", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      count += (u32)u64_le(bench_a[i], bench_b[i]);
+    }
+  }
+  bench_print("u64_le", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      count += (u32)i64_lt(bench_s[i], bench_s[BENCH_COUNT - 1 - i]);
+    }
+  }
+  bench_print("i64_lt", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  bench_sink = count;
+}
+
+static void bench_hash(void)
+{
+  clock_t start;
+  u64 h = u64_make(0, 0);
+  u32 r;
+  u32 i;
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    h = u64_hash_bytes(bench_bytes, BENCH_COUNT * 4, h);
+  }
+  bench_print_throughput("u64_hash_bytes (1 MiB)", start, clock(), (double)BENCH_ROUNDS * BENCH_COUNT * 4);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i + 16 <= BENCH_COUNT * 4; i += 16)
+    {
+      h = u64_xor(h, u64_hash_bytes(bench_bytes + i, 16, h));
+    }
+  }
+  bench_print_throughput("u64_hash_bytes (16 B)", start, clock(), (double)BENCH_ROUNDS * BENCH_COUNT * 4);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      h = u64_xor(h, u64_hash_splitmix(bench_a[i]));
+    }
+  }
+  bench_print("u64_hash_splitmix", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      h = u64_xor(h, u64_hash_murmur(bench_a[i]));
+    }
+  }
+  bench_print("u64_hash_murmur", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  bench_sink = u64_low(h);
+}
+
+static void bench_rng(void)
+{
+  clock_t start;
+  rng_xoshiro256 x = rng_xoshiro256_make(u64_make(0, 1));
+  rng_pcg32 p = rng_pcg32_make(u64_make(0, 1), u64_make(0, 1));
+  u32 r;
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    rng_xoshiro256_fill_u64(&x, bench_r, BENCH_COUNT);
+  }
+  bench_print("rng_xoshiro256_fill_u64", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    rng_pcg32_fill_u64(&p, bench_r, BENCH_COUNT);
+  }
+  bench_print("rng_pcg32_fill_u64", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  bench_sink = u64_low(bench_r[BENCH_COUNT - 1]);
+}
+
+static void bench_memory(void)
+{
+  static const u32 sizes[] = {1, 7, 16, 64, 256, 4096, 65536, BENCH_COUNT * 4};
+  /* Each size moves the same 256 MiB, the offsets walk the 1 MiB buffers */
+  double total = (double)BENCH_ROUNDS * BENCH_COUNT * 16;
+  char name[32];
+  clock_t start;
+  u32 s;
+  u32 n;
+  u32 i;
+
+  for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    u32 size = sizes[s];
+    u32 count = (u32)(total / size);
+    u32 span = BENCH_COUNT * 4 - size + 1;
+
+    start = clock();
+    for (n = 0, i = 0; n < count; ++n, i = (i + size + 3) % span)
+    {
+      types_memcpy(bench_dst + i, bench_bytes + (i ^ 1) % span, size);
+    }
+    sprintf(name, "types_memcpy %u B", size);
+    bench_print_throughput(name, start, clock(), total);
+
+    start = clock();
+    for (n = 0, i = 0; n < count; ++n, i = (i + size + 3) % span)
+    {
+      memcpy(bench_dst + i, bench_bytes + (i ^ 1) % span, size);
+    }
+    sprintf(name, "memcpy %u B", size);
+    bench_print_throughput(name, start, clock(), total);
+
+    start = clock();
+    for (n = 0, i = 0; n < count; ++n, i = (i + size + 3) % span)
+    {
+      types_memset(bench_dst + i, (u8)n, size);
+    }
+    sprintf(name, "types_memset %u B", size);
+    bench_print_throughput(name, start, clock(), total);
+
+    start = clock();
+    for (n = 0, i = 0; n < count; ++n, i = (i + size + 3) % span)
+    {
+      memset(bench_dst + i, (int)(n & 0xFF), size);
+    }
+    sprintf(name, "memset %u B", size);
+    bench_print_throughput(name, start, clock(), total);
+  }
+
+  start = clock();
+  for (n = 0; n < BENCH_ROUNDS * 4; ++n)
+  {
+    types_memmove(bench_dst + 1, bench_dst, BENCH_COUNT * 4 - 1);
+  }
+  bench_print_throughput("types_memmove (1 MiB)", start, clock(), total);
+
+  /* Equal buffers so the whole MiB is compared */
+  types_memcpy(bench_dst, bench_bytes, BENCH_COUNT * 4);
+  start = clock();
+  for (n = 0; n < BENCH_ROUNDS * 4; ++n)
+  {
+    bench_sink += (u32)types_memcmp(bench_dst, bench_bytes, BENCH_COUNT * 4);
+  }
+  bench_print_throughput("types_memcmp (1 MiB)", start, clock(), total);
+
+  /* The byte is not in the buffer so the whole MiB is scanned */
+  bench_bytes[0] = 0;
+  bench_dst[0] = 1;
+  for (i = 0; i < BENCH_COUNT * 4; ++i)
+  {
+    bench_dst[i] = bench_bytes[i] == 0x7F ? 0x7E : bench_bytes[i];
+  }
+  start = clock();
+  for (n = 0; n < BENCH_ROUNDS * 4; ++n)
+  {
+    bench_sink += types_memchr(bench_dst, 0x7F, BENCH_COUNT * 4) == 0;
+  }
+  bench_print_throughput("types_memchr (1 MiB)", start, clock(), total);
+
+  bench_sink += bench_dst[BENCH_COUNT];
+}
+
+static void bench_varint(void)
+{
+  clock_t start;
+  u32 size;
+  u32 r;
+  u32 i;
+
+  /* Mixed lengths so the codes do not repeat */
+  for (i = 0; i < BENCH_COUNT; ++i)
+  {
+    bench_u32[i] = bench_random() >> (bench_random() & 31);
+  }
+
+  size = u32_streamvbyte_encode(bench_stream, bench_u32, BENCH_COUNT);
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    bench_sink += u32_streamvbyte_decode(bench_u32, BENCH_COUNT, bench_stream, size);
+  }
+  bench_print("u32_streamvbyte_decode", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    bench_sink += u32_streamvbyte_encode(bench_stream, bench_u32, BENCH_COUNT);
+  }
+  bench_print("u32_streamvbyte_encode", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  size = 0;
+  for (i = 0; i < BENCH_COUNT; ++i)
+  {
+    size += u64_uleb128_encode(bench_stream + size, u64_make(bench_u32[i] >> 16, bench_u32[i]));
+  }
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    bench_sink += u64_uleb128_decode_n(bench_r, BENCH_COUNT, bench_stream, size);
+  }
+  bench_print("u64_uleb128_decode_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+}
+
+static void bench_format(void)
+{
+  char text[U64_DEC_MAX_CHARS];
+  clock_t start;
+  u32 length = 0;
+  u32 r;
+  u32 i;
+
+  /* Digit by digit with u64_divmod, the way it is done without u64_to_dec */
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 16; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      u64 x = bench_a[i];
+      u64 digit;
+      u32 n = 0;
+      do
+      {
+        x = u64_divmod(x, u64_make(0, 10), &digit);
+        text[n++] = (char)('0' + u64_low(digit));
+      } while (u64_high(x) | u64_low(x));
+      length += n;
+    }
+  }
+  bench_print("u64_divmod by 10 loop", start, clock(), BENCH_ROUNDS / 16 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 16; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      length += u64_to_dec(text, bench_a[i]);
+    }
+  }
+  bench_print("u64_to_dec", start, clock(), BENCH_ROUNDS / 16 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 16; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      length += u32_to_dec(text, u64_low(bench_a[i]) >> (bench_n[i] & 31));
+    }
+  }
+  bench_print("u32_to_dec", start, clock(), BENCH_ROUNDS / 16 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 16; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      length += u64_to_hex(text, bench_a[i]);
+    }
+  }
+  bench_print("u64_to_hex", start, clock(), BENCH_ROUNDS / 16 * BENCH_COUNT);
+
+  bench_sink = length + (u8)text[0];
+}
+
+static void bench_parse(void)
+{
+  clock_t start;
+  u64 sum = u64_make(0, 0);
+  u32 size = 0;
+  u32 count = 0;
+  u32 r;
+  u32 i;
+
+  /* Newline separated numbers of all magnitudes */
+  for (i = 0; size + U64_DEC_MAX_CHARS + 1 < BENCH_COUNT * 4; ++i)
+  {
+    size += u64_to_dec((char *)bench_dst + size, u64_shr(bench_a[i], bench_n[i]));
+    bench_dst[size++] = '\n';
+    ++count;
+  }
+
+  /* Digit by digit x * 10 + d, the way it is done without u64_parse_dec */
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 16; ++r)
+  {
+    for (i = 0; i < size; ++i)
+    {
+      u64 x = u64_make(0, 0);
+      for (; bench_dst[i] != '\n'; ++i)
+      {
+        x = u64_add(u64_mul(x, u64_make(0, 10)), u64_make(0, (u32)(bench_dst[i] - '0')));
+      }
+      sum = u64_add(sum, x);
+    }
+  }
+  bench_print("u64_mul/u64_add per digit", start, clock(), BENCH_ROUNDS / 16 * count);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 16; ++r)
+  {
+    for (i = 0; i < size; ++i)
+    {
+      u64 x = u64_make(0, 0);
+      i += u64_parse_dec(bench_dst + i, size - i, &x);
+      sum = u64_add(sum, x);
+    }
+  }
+  bench_print("u64_parse_dec", start, clock(), BENCH_ROUNDS / 16 * count);
+
+  bench_sink = u64_low(sum);
+}
+
+static void bench_float(void)
+{
+  clock_t start;
+  f32 fsum = 0.0f;
+  u32 r;
+  u32 i;
+
+  /* Signed values of all magnitudes below 2^63 */
+  for (i = 0; i < BENCH_COUNT; ++i)
+  {
+    bench_f64[i] = double_from_i64(i64_shr(bench_s[i], bench_n[i]));
+  }
+
+  /* Split into the u32 halves with FPU divide and multiply, the way it is done without i64_from_f64 */
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      f64 x = bench_f64[i];
+      f64 a = x < 0.0 ? -x : x;
+      u32 high = (u32)(a / 4294967296.0);
+      u64 v = u64_make(high, (u32)(a - (f64)high * 4294967296.0));
+      bench_s[i] = i64_from_u64(x < 0.0 ? u64_sub(u64_make(0, 0), v) : v);
+    }
+  }
+  bench_print("i64 from f64 via FPU halves", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    i64_from_f64_n(bench_s, bench_f64, BENCH_COUNT);
+  }
+  bench_print("i64_from_f64_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    i64_from_f64_sat_n(bench_s, bench_f64, BENCH_COUNT);
+  }
+  bench_print("i64_from_f64_sat_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    double_from_i64_n(bench_f64, bench_s, BENCH_COUNT);
+  }
+  bench_print("double_from_i64_n", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      fsum += f32_from_u64(bench_a[i]);
+    }
+  }
+  bench_print("f32_from_u64", start, clock(), BENCH_ROUNDS * BENCH_COUNT);
+
+  bench_sink = f32_to_bits(fsum) + i64_low(bench_s[0]);
+}
+
+static void bench_math(void)
+{
+  clock_t start;
+  f32 sum = 0.0f;
+  u32 r;
+  u32 i;
+
+  /* Positive values in [0, 64) */
+  for (i = 0; i < BENCH_COUNT; ++i)
+  {
+    bench_f32[i] = (f32)(bench_random() >> 8) * (1.0f / 262144.0f);
+  }
+
+  /* One call per element against the blocks of the _n form */
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 4; ++r)
+  {
+    for (i = 0; i < BENCH_COUNT; ++i)
+    {
+      sum += f32_exp(bench_f32[i] - 32.0f);
+    }
+  }
+  bench_print("f32_exp", start, clock(), BENCH_ROUNDS / 4 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 4; ++r)
+  {
+    f32_exp_n(bench_f32_r, bench_f32, BENCH_COUNT);
+  }
+  bench_print("f32_exp_n", start, clock(), BENCH_ROUNDS / 4 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 4; ++r)
+  {
+    f32_log_n(bench_f32_r, bench_f32, BENCH_COUNT);
+  }
+  bench_print("f32_log_n", start, clock(), BENCH_ROUNDS / 4 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 4; ++r)
+  {
+    f32_sin_n(bench_f32_r, bench_f32, BENCH_COUNT);
+  }
+  bench_print("f32_sin_n", start, clock(), BENCH_ROUNDS / 4 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 4; ++r)
+  {
+    f32_sqrt_n(bench_f32_r, bench_f32, BENCH_COUNT);
+  }
+  bench_print("f32_sqrt_n", start, clock(), BENCH_ROUNDS / 4 * BENCH_COUNT);
+
+  start = clock();
+  for (r = 0; r < BENCH_ROUNDS / 4; ++r)
+  {
+    f32_rsqrt_fast_n(bench_f32_r, bench_f32, BENCH_COUNT);
+  }
+  bench_print("f32_rsqrt_fast_n", start, clock(), BENCH_ROUNDS / 4 * BENCH_COUNT);
+
+  bench_sink = f32_to_bits(sum + bench_f32_r[0]);
+}
+
+int main(void)
+{
+#ifdef TYPES_NATIVE64
+  printf("u64 representation: native\n");
+#else
+  printf("u64 representation: emulated\n");
+#endif
+#ifdef TYPES_BRANCHLESS
+  printf("mode: branchless\n");
+#else
+  printf("mode: branching\n");
+#endif
+#if defined(TYPES_SIMD_SSE2)
+  printf("simd: sse2\n");
+#elif defined(TYPES_SIMD_NEON)
+  printf("simd: neon\n");
+#endif
+
+  bench_init();
+  bench_arith();
+  bench_shifts();
+  bench_compares();
+  bench_batch();
+  bench_sums();
+  bench_hash();
+  bench_rng();
+  bench_memory();
+  bench_varint();
+  bench_format();
+  bench_parse();
+  bench_float();
+  bench_math();
+
+  return 0;
+}
+
+/*
+   ------------------------------------------------------------------------------
+   This software is available under 2 licenses -- choose whichever you prefer.
+   ------------------------------------------------------------------------------
+   ALTERNATIVE A - MIT License
+   Copyright (c) 2025 nickscha
+   Permission is hereby granted, free of charge, to any person obtaining a copy of
+   this software and associated documentation files (the "Software"), to deal in
+   the Software without restriction, including without limitation the rights to
+   use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+   of the Software, and to permit persons to whom the Software is furnished to do
+   so, subject to the following conditions:
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+   SOFTWARE.
+   ------------------------------------------------------------------------------
+   ALTERNATIVE B - Public Domain (www.unlicense.org)
+   This is free and unencumbered software released into the public domain.
+   Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+   software, either in source code form or as a compiled binary, for any purpose,
+   commercial or non-commercial, and by any means.
+   In jurisdictions that recognize copyright laws, the author or authors of this
+   software dedicate any and all copyright interest in the software to the public
+   domain. We make this dedication for the benefit of the public at large and to
+   the detriment of our heirs and successors. We intend this dedication to be an
+   overt act of relinquishment in perpetuity of all present and future rights to
+   this software under copyright law.
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+   AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+   ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+   WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+   ------------------------------------------------------------------------------
+*/
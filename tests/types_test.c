@@ -55,6 +55,12 @@ void types_test_booleans(void)
 void types_test_bit_macros(void)
 {
   u8 x = 0;
+  u32 w;
+  u8 bytes[2];
+  u8 *p;
+#ifdef TYPES_NATIVE64
+  u64 wide;
+#endif
 
   BIT_SET(x, 3);
   assert(x == 8); /* 00001000 */
@@ -67,8 +73,30 @@ void types_test_bit_macros(void)
 
   assert(BIT_CHECK(x, 1) == 1);
   assert(BIT_CHECK(x, 3) == 0);
+
+  /* Wider than u8 */
+  w = 0xFFFFFFFF;
+  BIT_CLEAR(w, 31);
+  BIT_CLEAR(w, 8);
+  assert(w == 0x7FFFFEFF);
+
+  /* x is evaluated once */
+  bytes[0] = 0xFF;
+  bytes[1] = 0xFF;
+  p = bytes;
+  BIT_CLEAR(*p++, 3);
+  assert(p == bytes + 1 && bytes[0] == 0xF7 && bytes[1] == 0xFF);
+
+#ifdef TYPES_NATIVE64
+  /* 64-bit words keep their upper half */
+  wide = u64_make(0xFFFFFFFF, 0xFFFFFFFF);
+  BIT_CLEAR(wide, 3);
+  assert(u64_eq(wide, u64_make(0xFFFFFFFF, 0xFFFFFFF7)));
+#endif
 }
 
+#ifndef TYPES_NATIVE64
+/* Tests the struct layout of the C89 emulation */
 void types_test_u64(void)
 {
   u64 zero = {0, 0};
@@ -89,6 +117,10 @@ void types_test_u64(void)
   assert(u64_sub(two, one).low == one.low && u64_sub(two, one).high == one.high);
   assert(u64_sub(one, one).low == zero.low && u64_sub(one, one).high == zero.high);
 
+  /* Multiplication */
+  assert(u64_mul(two, three).low == 6 && u64_mul(two, three).high == 0);
+  assert(u64_mul(low_max, low_max).low == 1 && u64_mul(low_max, low_max).high == 0xFFFFFFFE);
+
   /* Bitwise operations */
   assert(u64_and(one, two).low == 0 && u64_and(one, two).high == 0);
   assert(u64_or(one, two).low == three.low && u64_or(one, two).high == three.high);
@@ -115,6 +147,1390 @@ void types_test_i64(void)
   assert(i64_or(one, two).low == three.low && i64_or(one, two).high == three.high);
   assert(i64_xor(one, two).low == three.low && i64_xor(one, two).high == three.high);
 }
+#endif
+
+void types_test_u64_api(void)
+{
+  u64 zero = u64_make(0, 0);
+  u64 one = u64_make(0, 1);
+  u64 max = u64_make(0xFFFFFFFF, 0xFFFFFFFF);
+  i64 minus_one = i64_make(-1, 0xFFFFFFFF);
+  i64 minus_big = i64_make(-0x01234568, 0x76543211);
+
+  /* Identical results for the native and the emulated representation */
+  assert(u64_high(max) == 0xFFFFFFFF && u64_low(one) == 1);
+  assert(u64_eq(u64_add(max, one), zero) && u64_eq(u64_sub(zero, one), max));
+  assert(u64_eq(u64_shl(one, 63), u64_make(0x80000000, 0)) && u64_eq(u64_shl(one, 64), zero));
+  assert(u64_eq(u64_shr(max, 60), u64_make(0, 15)) && u64_eq(u64_shr(max, 0), max));
+  assert(u64_lt(one, max) && u64_le(one, one) && u64_gt(max, zero) && u64_ge(max, max) && u64_ne(one, zero));
+  assert(u64_eq(u64_from_u32(7), u64_make(0, 7)) && u64_eq(u64_from_i64(minus_one), max));
+
+  assert(i64_eq(i64_neg(minus_one), i64_make(0, 1)));
+  assert(i64_eq(i64_shr(minus_big, 36), i64_make(-1, 0xFFEDCBA9)) && i64_eq(i64_shr(minus_big, 64), minus_one));
+  assert(i64_eq(i64_shl(minus_one, 32), i64_make(-1, 0)));
+
+  /* Counts of 128 and more, the NEON shifts only look at the low byte */
+  assert(u64_eq(u64_shl(one, 200), zero) && u64_eq(u64_shl(max, 961), zero) && u64_eq(u64_shr(max, 128), zero));
+  assert(i64_eq(i64_shr(minus_big, 200), minus_one) && i64_eq(i64_shr(i64_make(1, 0), 300), i64_make(0, 0)));
+  assert(i64_lt(minus_big, minus_one) && i64_le(minus_one, minus_one) && i64_gt(minus_one, minus_big));
+  assert(i64_eq(i64_from_i32(-2), i64_make(-1, 0xFFFFFFFE)) && i64_high(minus_big) == -0x01234568 && i64_low(minus_big) == 0x76543211);
+  assert(double_from_u64(u64_make(1, 0)) == 4294967296.0 && double_from_i64(minus_one) == -1.0);
+}
+
+/* The pointer variants work on the words, check them against the by-value operations */
+void types_test_u64_to_matches(void)
+{
+  static const u32 words[][2] = {
+      {0, 0}, {0, 1}, {0, 7}, {0, 0xFFFFFFFF}, {1, 0}, {3, 0x80000001},
+      {0x7FFFFFFF, 0xFFFFFFFF}, {0x80000000, 0}, {0xFFFFFFFF, 0xFFFFFFF9}, {0xFFFFFFFF, 0xFFFFFFFF}};
+  static const int shifts[] = {-1, 0, 1, 31, 32, 33, 63, 64, 100};
+  u32 count = (u32)(sizeof(words) / sizeof(words[0]));
+  b32 ok = 1;
+  u32 i, j, k;
+
+  for (i = 0; i < count; ++i)
+  {
+    for (j = 0; j < count; ++j)
+    {
+      u64 a = u64_make(words[i][0], words[i][1]);
+      u64 b = u64_make(words[j][0], words[j][1]);
+      i64 sa = i64_from_u64(a);
+      i64 sb = i64_from_u64(b);
+      u64 r;
+      i64 s;
+
+      u64_and_to(&r, &a, &b);
+      ok &= u64_eq(r, u64_and(a, b));
+      u64_or_to(&r, &a, &b);
+      ok &= u64_eq(r, u64_or(a, b));
+      u64_xor_to(&r, &a, &b);
+      ok &= u64_eq(r, u64_xor(a, b));
+      u64_add_to(&r, &a, &b);
+      ok &= u64_eq(r, u64_add(a, b));
+      u64_sub_to(&r, &a, &b);
+      ok &= u64_eq(r, u64_sub(a, b));
+      u64_mul_to(&r, &a, &b);
+      ok &= u64_eq(r, u64_mul(a, b));
+      u64_add_u32_to(&r, &a, words[j][1]);
+      ok &= u64_eq(r, u64_add_u32(a, words[j][1]));
+      u64_sub_u32_to(&r, &a, words[j][1]);
+      ok &= u64_eq(r, u64_sub_u32(a, words[j][1]));
+      u64_mul_u32_to(&r, &a, words[j][1]);
+      ok &= u64_eq(r, u64_mul_u32(a, words[j][1]));
+      i64_and_to(&s, &sa, &sb);
+      ok &= i64_eq(s, i64_and(sa, sb));
+      i64_or_to(&s, &sa, &sb);
+      ok &= i64_eq(s, i64_or(sa, sb));
+      i64_xor_to(&s, &sa, &sb);
+      ok &= i64_eq(s, i64_xor(sa, sb));
+      i64_add_to(&s, &sa, &sb);
+      ok &= i64_eq(s, i64_add(sa, sb));
+      i64_sub_to(&s, &sa, &sb);
+      ok &= i64_eq(s, i64_sub(sa, sb));
+      i64_mul_to(&s, &sa, &sb);
+      ok &= i64_eq(s, i64_mul(sa, sb));
+      i64_add_i32_to(&s, &sa, (i32)words[j][1]);
+      ok &= i64_eq(s, i64_add_i32(sa, (i32)words[j][1]));
+      i64_sub_i32_to(&s, &sa, (i32)words[j][1]);
+      ok &= i64_eq(s, i64_sub_i32(sa, (i32)words[j][1]));
+      i64_mul_i32_to(&s, &sa, (i32)words[j][1]);
+      ok &= i64_eq(s, i64_mul_i32(sa, (i32)words[j][1]));
+
+      if (!u64_eq(b, u64_make(0, 0)))
+      {
+        u64_div_to(&r, &a, &b);
+        ok &= u64_eq(r, u64_div(a, b));
+        u64_mod_to(&r, &a, &b);
+        ok &= u64_eq(r, u64_mod(a, b));
+        i64_div_to(&s, &sa, &sb);
+        ok &= i64_eq(s, i64_div(sa, sb));
+        i64_mod_to(&s, &sa, &sb);
+        ok &= i64_eq(s, i64_mod(sa, sb));
+        /* Result aliasing the divisor */
+        r = b;
+        u64_div_to(&r, &a, &r);
+        ok &= u64_eq(r, u64_div(a, b));
+        r = b;
+        u64_mod_to(&r, &a, &r);
+        ok &= u64_eq(r, u64_mod(a, b));
+      }
+    }
+
+    for (k = 0; k < sizeof(shifts) / sizeof(shifts[0]); ++k)
+    {
+      u64 a = u64_make(words[i][0], words[i][1]);
+      i64 sa = i64_from_u64(a);
+      u64 r;
+      i64 s;
+      u64_shl_to(&r, &a, shifts[k]);
+      ok &= u64_eq(r, u64_shl(a, shifts[k]));
+      u64_shr_to(&r, &a, shifts[k]);
+      ok &= u64_eq(r, u64_shr(a, shifts[k]));
+      i64_shl_to(&s, &sa, shifts[k]);
+      ok &= i64_eq(s, i64_shl(sa, shifts[k]));
+      i64_shr_to(&s, &sa, shifts[k]);
+      ok &= i64_eq(s, i64_shr(sa, shifts[k]));
+    }
+
+    {
+      u64 a = u64_make(words[i][0], words[i][1]);
+      i64 sa = i64_from_u64(a);
+      u64 r;
+      i64 s;
+      u64_not_to(&r, &a);
+      ok &= u64_eq(r, u64_not(a));
+      i64_not_to(&s, &sa);
+      ok &= i64_eq(s, i64_not(sa));
+      i64_neg_to(&s, &sa);
+      ok &= i64_eq(s, i64_neg(sa));
+    }
+  }
+  assert(ok);
+}
+
+void types_test_u64_to(void)
+{
+  u64 sum = u64_make(0, 0xFFFFFFFF);
+  u64 one = u64_make(0, 1);
+  u64 r;
+  i64 acc = i64_make(0, 5);
+  i64 minus_two = i64_make(-1, 0xFFFFFFFE);
+
+  /* Result aliasing an operand */
+  u64_add_to(&sum, &sum, &one);
+  assert(u64_eq(sum, u64_make(1, 0)));
+  u64_mul_to(&sum, &sum, &sum);
+  assert(u64_eq(sum, u64_make(0, 0)));
+  u64_add_u32_to(&sum, &sum, 10);
+  u64_shl_to(&sum, &sum, 40);
+  u64_shr_to(&sum, &sum, 39);
+  assert(u64_eq(sum, u64_make(0, 20)));
+  u64_not_to(&r, &sum);
+  u64_xor_to(&r, &r, &sum);
+  assert(u64_eq(r, u64_make(0xFFFFFFFF, 0xFFFFFFFF)));
+  u64_div_to(&r, &sum, &one);
+  u64_mod_to(&sum, &sum, &r);
+  assert(u64_eq(r, u64_make(0, 20)) && u64_eq(sum, u64_make(0, 0)));
+
+  i64_mul_to(&acc, &acc, &minus_two);
+  i64_sub_i32_to(&acc, &acc, 2);
+  assert(i64_eq(acc, i64_make(-1, 0xFFFFFFF4)));
+  i64_neg_to(&acc, &acc);
+  i64_div_to(&acc, &acc, &minus_two);
+  assert(i64_eq(acc, i64_make(-1, 0xFFFFFFFA)));
+
+  types_test_u64_to_matches();
+}
+
+void types_test_u64_divmod(void)
+{
+  u64 zero = u64_make(0, 0);
+  u64 one = u64_make(0, 1);
+  u64 seven = u64_make(0, 7);
+  u64 ten = u64_make(0, 10);
+  u64 max = u64_make(0xFFFFFFFF, 0xFFFFFFFF);
+  u64 big = u64_make(0x01234567, 0x89ABCDEF);
+  u64 big_divisor = u64_make(0x00000100, 0x00000001);
+  u64 q;
+  u64 r;
+  u32 seed = 12345;
+  int i;
+
+  /* Both operands fit into 32 bits */
+  q = u64_divmod(ten, seven, &r);
+  assert(u64_eq(q, one) && u64_eq(r, u64_make(0, 3)));
+  assert(u64_eq(u64_div(zero, seven), zero) && u64_eq(u64_mod(zero, seven), zero));
+
+  /* 64-bit dividend, 32-bit divisor */
+  q = u64_divmod(big, ten, &r);
+  assert(u64_eq(q, u64_make(0x001D208A, 0x5A912E31)) && u64_eq(r, u64_make(0, 5)));
+  assert(u64_eq(u64_div(max, one), max));
+  assert(u64_eq(u64_mod(max, one), zero));
+
+  /* 64-bit divisor */
+  q = u64_divmod(big, big_divisor, &r);
+  assert(u64_eq(q, u64_make(0, 0x00012345)) && u64_eq(r, u64_make(0x00000067, 0x89AAAAAA)));
+  q = u64_divmod(big_divisor, big, &r);
+  assert(u64_eq(q, zero) && u64_eq(r, big_divisor));
+  assert(u64_eq(u64_div(max, max), one));
+
+  /* dividend == quotient * divisor + remainder, remainder < divisor */
+  for (i = 0; i < 64; ++i)
+  {
+    u32 n_high, n_low, d_high, d_low;
+    u64 n;
+    u64 d;
+
+    seed = seed * 1664525 + 1013904223;
+    n_high = seed;
+    seed = seed * 1664525 + 1013904223;
+    n_low = seed;
+    seed = seed * 1664525 + 1013904223;
+    d_high = seed >> (i & 31);
+    seed = seed * 1664525 + 1013904223;
+    d_low = seed | 1;
+
+    n = u64_make(n_high, n_low);
+    d = u64_make(d_high, d_low);
+    q = u64_divmod(n, d, &r);
+    test(u64_lt(r, d) && u64_eq(u64_add(u64_mul(q, d), r), n));
+  }
+}
+
+void types_test_u64_mixed(void)
+{
+  u64 low_max = u64_make(0, 0xFFFFFFFF);
+  u64 big = u64_make(0x01234567, 0x89ABCDEF);
+  i64 minus_one = i64_make(-1, 0xFFFFFFFF);
+  i64 minus_big = i64_make(-0x01234568, 0x76543211);
+  i32 ir;
+  u32 r;
+  u64 q;
+
+  /* Addition and subtraction carry into the high word */
+  assert(u64_eq(u64_add_u32(low_max, 1), u64_make(1, 0)));
+  assert(u64_eq(u64_sub_u32(u64_add_u32(low_max, 1), 1), low_max));
+
+  /* Multiplication */
+  assert(u64_eq(u64_mul_u32(low_max, 0xFFFFFFFF), u64_make(0xFFFFFFFE, 1)));
+  assert(u64_eq(u64_mul_u32(big, 1000), u64_make(0x71C71C71, 0xC71C6D98)));
+
+  /* Division */
+  q = u64_divmod_u32(big, 1000, &r);
+  assert(u64_eq(q, u64_make(0x00004A90, 0xBE587DE6)) && r == 895);
+  assert(u64_eq(u64_div_u32(low_max, 16), u64_make(0, 0x0FFFFFFF)) && u64_mod_u32(low_max, 16) == 15);
+
+  /* Signed */
+  assert(i64_eq(i64_add_i32(minus_one, 1), i64_make(0, 0)));
+  assert(i64_eq(i64_sub_i32(minus_one, -2), i64_make(0, 1)));
+  assert(i64_eq(i64_mul_i32(minus_one, -5), i64_make(0, 5)));
+  assert(i64_eq(i64_mul_i32(minus_big, 1), minus_big));
+  assert(i64_eq(i64_div_i32(minus_big, 1000), i64_make(-0x00004A91, 0x41A7821A)));
+  assert(i64_mod_i32(minus_big, 1000) == -895);
+  assert(i64_eq(i64_div_i32(minus_big, I32_MIN), i64_make(0, 0x02468ACF)));
+  i64_divmod_i32(minus_big, -7, &ir);
+  assert(ir == -6);
+}
+
+void types_test_u128(void)
+{
+  u64 max = u64_make(0xFFFFFFFF, 0xFFFFFFFF);
+  u64 one = u64_make(0, 1);
+  u64 big = u64_make(0x01234567, 0x89ABCDEF);
+  u128 p;
+  i128 s;
+
+  /* (2^64 - 1)^2 = 2^128 - 2^65 + 1 */
+  p = u64_mul_wide(max, max);
+  assert(u64_eq(u128_high(p), u64_make(0xFFFFFFFF, 0xFFFFFFFE)) && u64_eq(u128_low(p), one));
+  assert(u64_eq(u64_mulhi(big, big), u64_make(0x00014B66, 0xDC33F6AC)));
+  assert(u64_eq(u64_mulhi(big, one), u64_make(0, 0)));
+
+  /* Carry and borrow across the 64-bit boundary */
+  p = u128_add(u128_from_u64(max), u128_from_u64(one));
+  assert(u64_eq(u128_high(p), one) && u64_eq(u128_low(p), u64_make(0, 0)));
+  p = u128_sub(p, u128_from_u64(one));
+  assert(u128_eq(p, u128_from_u64(max)));
+
+  /* Shifts */
+  assert(u128_eq(u128_shl(u128_from_u64(one), 100), u128_make(u64_make(0x10, 0), u64_make(0, 0))));
+  assert(u128_eq(u128_shr(u128_make(big, max), 68), u128_from_u64(u64_make(0x00123456, 0x789ABCDE))));
+  assert(u128_eq(u128_shl(u128_from_u64(one), 128), u128_from_u64(u64_make(0, 0))));
+
+  /* Comparisons */
+  assert(u128_lt(u128_from_u64(max), u128_make(one, u64_make(0, 0))));
+  assert(u128_ge(u128_make(one, u64_make(0, 0)), u128_from_u64(max)));
+
+  /* Signed */
+  s = i64_mul_wide(i64_from_u64(max), i64_from_u64(big));
+  assert(i128_eq(s, i128_neg(i128_from_u128(u128_from_u64(big)))));
+  assert(i128_lt(s, i128_from_u128(u128_from_u64(one))));
+  assert(i128_eq(i128_shr(i128_shl(s, 60), 60), s));
+  assert(u64_eq(u64_from_i64(i64_mulhi(i64_from_u64(max), i64_from_u64(big))), max));
+}
+
+void types_test_divider(void)
+{
+  u32_divider d7 = u32_divider_make(7);
+  u32_divider d1 = u32_divider_make(1);
+  u32_divider dmax = u32_divider_make(0xFFFFFFFF);
+  u64_divider q1000 = u64_divider_make(u64_make(0, 1000));
+  u64_divider qbig = u64_divider_make(u64_make(0x00000100, 0x00000001));
+  u64 big = u64_make(0x01234567, 0x89ABCDEF);
+  u32 i;
+
+  assert(u32_divider_div(&d7, 100) == 14 && u32_divider_mod(&d7, 100) == 2);
+  assert(u32_divider_div(&d7, 0xFFFFFFFF) == 613566756 && u32_divider_mod(&d7, 0xFFFFFFFF) == 3);
+  assert(u32_divider_div(&d1, 0xFFFFFFFF) == 0xFFFFFFFF);
+  assert(u32_divider_div(&dmax, 0xFFFFFFFF) == 1 && u32_divider_div(&dmax, 0xFFFFFFFE) == 0);
+
+  assert(u64_eq(u64_divider_div(&q1000, big), u64_make(0x00004A90, 0xBE587DE6)));
+  assert(u64_eq(u64_divider_mod(&q1000, big), u64_make(0, 895)));
+  assert(u64_eq(u64_divider_div(&qbig, big), u64_make(0, 0x00012345)));
+  assert(u64_eq(u64_divider_mod(&qbig, big), u64_make(0x00000067, 0x89AAAAAA)));
+
+  /* Matches the plain division for every small divisor */
+  for (i = 1; i < 64; ++i)
+  {
+    u32_divider d = u32_divider_make(i);
+    u64_divider q = u64_divider_make(u64_make(0, i));
+    test(u32_divider_div(&d, 0xDEADBEEF) == 0xDEADBEEF / i);
+    test(u64_eq(u64_divider_div(&q, big), u64_div(big, u64_make(0, i))));
+  }
+}
+
+void types_test_i64_divmod(void)
+{
+  i64 seven = i64_make(0, 7);
+  i64 minus_seven = i64_make(-1, 0xFFFFFFF9);
+  i64 two = i64_make(0, 2);
+  i64 minus_two = i64_make(-1, 0xFFFFFFFE);
+  i64 minus_one = i64_make(-1, 0xFFFFFFFF);
+  i64 one = i64_make(0, 1);
+  i64 big = i64_make(0x01234567, 0x89ABCDEF);
+  i64 min = i64_make((i32)0x80000000, 0);
+  i64 zero = i64_make(0, 0);
+  i64 r;
+  i64 q;
+  i32 r32;
+
+  /* Multiplication wraps like two's complement */
+  assert(i64_eq(i64_mul(minus_seven, two), i64_make(-1, 0xFFFFFFF2)));
+  assert(i64_eq(i64_mul(minus_seven, minus_two), i64_make(0, 14)));
+  assert(i64_eq(i64_mul(big, minus_two), i64_make(-0x02468AD0, 0xECA86422)));
+
+  /* Truncating: -7 / 2 = -3 rem -1 */
+  q = i64_divmod(minus_seven, two, &r);
+  assert(i64_eq(q, i64_make(-1, 0xFFFFFFFD)) && i64_eq(r, minus_one));
+  assert(i64_eq(i64_div(seven, minus_two), i64_make(-1, 0xFFFFFFFD)) && i64_eq(i64_mod(seven, minus_two), one));
+
+  /* Floored: -7 / 2 = -4 rem 1, 7 / -2 = -4 rem -1 */
+  q = i64_divmod_floor(minus_seven, two, &r);
+  assert(i64_eq(q, i64_make(-1, 0xFFFFFFFC)) && i64_eq(r, one));
+  q = i64_divmod_floor(seven, minus_two, &r);
+  assert(i64_eq(q, i64_make(-1, 0xFFFFFFFC)) && i64_eq(r, minus_one));
+  assert(i64_eq(i64_div_floor(seven, two), i64_make(0, 3)) && i64_eq(i64_mod_floor(seven, two), one));
+
+  /* Euclidean: -7 / -2 = 4 rem 1, -7 / 2 = -4 rem 1 */
+  q = i64_divmod_euclid(minus_seven, minus_two, &r);
+  assert(i64_eq(q, i64_make(0, 4)) && i64_eq(r, one));
+  assert(i64_eq(i64_div_euclid(minus_seven, two), i64_make(-1, 0xFFFFFFFC)) && i64_eq(i64_mod_euclid(minus_seven, two), one));
+
+  /* I64_MIN / -1 wraps to I64_MIN with remainder 0 in both modes */
+  q = i64_divmod(min, minus_one, &r);
+  assert(i64_eq(q, min) && i64_eq(r, zero));
+  assert(i64_eq(i64_div(min, minus_one), min) && i64_eq(i64_mod(min, minus_one), zero));
+  q = i64_divmod_floor(min, minus_one, &r);
+  assert(i64_eq(q, min) && i64_eq(r, zero));
+  q = i64_divmod_euclid(min, minus_one, &r);
+  assert(i64_eq(q, min) && i64_eq(r, zero));
+  q = i64_divmod_i32(min, -1, &r32);
+  assert(i64_eq(q, min) && r32 == 0);
+  assert(i64_eq(i64_div_i32(min, -1), min) && i64_mod_i32(min, -1) == 0);
+  assert(i64_eq(i64_div(big, minus_one), i64_neg(big)) && i64_eq(i64_div_i32(big, -1), i64_neg(big)));
+}
+
+void types_test_u64_n(void)
+{
+  u64 a[4];
+  u64 b[4];
+  u64 r[4];
+  i64 sa[4];
+  i64 sb[4];
+  i64 sr[4];
+  b8 m[4];
+  u32 i;
+
+  a[0] = u64_make(0, 0xFFFFFFFF);
+  b[0] = u64_make(0, 1);
+  a[1] = u64_make(1, 0);
+  b[1] = u64_make(0, 1);
+  a[2] = u64_make(0x12345678, 0x9ABCDEF0);
+  b[2] = u64_make(0x0FEDCBA9, 0x87654321);
+  a[3] = u64_make(7, 5);
+  b[3] = u64_make(7, 5);
+
+  /* Must match the scalar operations */
+  u64_add_n(r, a, b, 4);
+  for (i = 0; i < 4; ++i)
+  {
+    assert(u64_eq(r[i], u64_add(a[i], b[i])));
+  }
+  u64_sub_n(r, a, b, 4);
+  for (i = 0; i < 4; ++i)
+  {
+    assert(u64_eq(r[i], u64_sub(a[i], b[i])));
+  }
+  u64_mul_n(r, a, b, 4);
+  for (i = 0; i < 4; ++i)
+  {
+    assert(u64_eq(r[i], u64_mul(a[i], b[i])));
+  }
+  u64_xor_n(r, a, b, 4);
+  assert(u64_eq(r[3], u64_make(0, 0)));
+  u64_and_n(r, a, b, 4);
+  u64_or_n(r + 1, a + 1, b + 1, 1);
+  assert(u64_eq(r[0], u64_make(0, 1)) && u64_eq(r[1], u64_make(1, 1)));
+
+  u64_cmp_lt_n(m, a, b, 4);
+  assert(m[0] == 0 && m[1] == 0 && m[2] == 0 && m[3] == 0);
+  u64_cmp_lt_n(m, b, a, 4);
+  assert(m[0] == 1 && m[1] == 1 && m[2] == 1 && m[3] == 0);
+  u64_cmp_eq_n(m, a, b, 4);
+  assert(m[0] == 0 && m[1] == 0 && m[2] == 0 && m[3] == 1);
+
+  sa[0] = i64_make(-1, 0xFFFFFFFF);
+  sb[0] = i64_make(0, 1);
+  sa[1] = i64_make(I32_MIN, 0);
+  sb[1] = i64_make(0, 1);
+  sa[2] = i64_make(-5, 3);
+  sb[2] = i64_make(4, 0x80000000);
+  sa[3] = i64_make(-2, 0);
+  sb[3] = i64_make(-2, 0);
+
+  i64_add_n(sr, sa, sb, 4);
+  for (i = 0; i < 4; ++i)
+  {
+    assert(i64_eq(sr[i], i64_add(sa[i], sb[i])));
+  }
+  i64_sub_n(sr, sa, sb, 4);
+  for (i = 0; i < 4; ++i)
+  {
+    assert(i64_eq(sr[i], i64_sub(sa[i], sb[i])));
+  }
+  i64_mul_n(sr, sa, sb, 4);
+  for (i = 0; i < 4; ++i)
+  {
+    assert(i64_eq(sr[i], i64_mul(sa[i], sb[i])));
+  }
+
+  i64_cmp_lt_n(m, sa, sb, 4);
+  assert(m[0] == 1 && m[1] == 1 && m[2] == 1 && m[3] == 0);
+  i64_cmp_eq_n(m, sa, sb, 4);
+  assert(m[0] == 0 && m[1] == 0 && m[2] == 0 && m[3] == 1);
+}
+
+static u32 types_test_big[65536 + 3];
+static u64 types_test_big64[65536 + 3];
+
+void types_test_sums(void)
+{
+  u64 a[3];
+  u64 r[3];
+  u32 x[3];
+  u32 y[3];
+  u32 i;
+
+  a[0] = u64_make(0xFFFFFFFF, 0xFFFFFFFF);
+  a[1] = u64_make(0, 2);
+  a[2] = u64_make(0x12345678, 0x9ABCDEF0);
+
+  assert(u64_eq(u64_sum_n(a, 0), u64_make(0, 0)));
+  assert(u64_eq(u64_sum_n(a, 3), u64_make(0x12345678, 0x9ABCDEF1)));
+
+  /* In-place scan */
+  u64_prefix_sum_n(r, a, 3);
+  assert(u64_eq(r[0], a[0]) && u64_eq(r[1], u64_make(0, 1)));
+  u64_prefix_sum_n(a, a, 3);
+  assert(u64_eq(a[2], u64_make(0x12345678, 0x9ABCDEF1)));
+
+  x[0] = 0xFFFFFFFF;
+  x[1] = 3;
+  x[2] = 0x80000000;
+  y[0] = 0xFFFFFFFF;
+  y[1] = 5;
+  y[2] = 2;
+  assert(u64_eq(u32_sum_u64(x, 3), u64_make(1, 0x80000002)));
+  /* 0xFFFFFFFE00000001 + 15 + 0x100000000 */
+  assert(u64_eq(u32_dot_u64(x, y, 3), u64_make(0xFFFFFFFF, 0x00000010)));
+
+  /* Crosses the internal carry blocks with all bits set */
+  for (i = 0; i < 65536 + 3; ++i)
+  {
+    types_test_big[i] = 0xFFFFFFFF;
+    types_test_big64[i] = u64_make(0, 0xFFFFFFFF);
+  }
+  /* 65539 * 0xFFFFFFFF */
+  assert(u64_eq(u32_sum_u64(types_test_big, 65536 + 3), u64_make(0x10002, 0xFFFEFFFD)));
+  assert(u64_eq(u64_sum_n(types_test_big64, 65536 + 3), u64_make(0x10002, 0xFFFEFFFD)));
+  /* 65539 * 0xFFFFFFFE00000001 */
+  assert(u64_eq(u32_dot_u64(types_test_big, types_test_big, 65536 + 3), u64_make(0xFFFDFFFA, 0x00010003)));
+}
+
+void types_test_bits(void)
+{
+  u64 x = u64_make(0x00F00000, 0x00000100);
+
+  assert(u32_popcount(0) == 0);
+  assert(u32_popcount(0xFFFFFFFF) == 32);
+  assert(u32_popcount(0x80000001) == 2);
+  assert(u32_clz(0) == 32 && u32_clz(1) == 31 && u32_clz(0x80000000) == 0);
+  assert(u32_ctz(0) == 32 && u32_ctz(1) == 0 && u32_ctz(0x80000000) == 31);
+  assert(u32_ctz(0x00050000) == 16);
+  assert(u32_bswap(0x12345678) == 0x78563412);
+  assert(u32_rotl(0x80000001, 1) == 0x00000003);
+  assert(u32_rotr(0x80000001, 1) == 0xC0000000);
+  assert(u32_rotl(0x12345678, 0) == 0x12345678 && u32_rotr(0x12345678, 32) == 0x12345678);
+
+  assert(u64_popcount(x) == 5);
+  assert(u64_popcount(u64_make(0xFFFFFFFF, 0xFFFFFFFF)) == 64);
+  assert(u64_clz(x) == 8 && u64_ctz(x) == 8);
+  assert(u64_clz(u64_make(0, 1)) == 63 && u64_ctz(u64_make(1, 0)) == 32);
+  assert(u64_clz(u64_make(0, 0)) == 64 && u64_ctz(u64_make(0, 0)) == 64);
+  assert(u64_eq(u64_bswap(u64_make(0x01020304, 0x05060708)), u64_make(0x08070605, 0x04030201)));
+  assert(u64_eq(u64_rotl(u64_make(0x80000000, 1), 1), u64_make(0, 3)));
+  assert(u64_eq(u64_rotl(u64_make(0x12345678, 0x9ABCDEF0), 36), u64_make(0xABCDEF01, 0x23456789)));
+  assert(u64_eq(u64_rotr(u64_make(0x12345678, 0x9ABCDEF0), 36), u64_make(0x89ABCDEF, 0x01234567)));
+  assert(u64_eq(u64_rotr(x, 64), x) && u64_eq(u64_rotl(x, 32), u64_make(0x00000100, 0x00F00000)));
+}
+
+void types_test_bitset(void)
+{
+  u32 words_a[BITSET_WORDS(100)];
+  u32 words_b[BITSET_WORDS(100)];
+  bitset a = bitset_make(words_a, 100);
+  bitset b = bitset_make(words_b, 100);
+  u32 i;
+  u32 n;
+
+  assert(BITSET_WORDS(100) == 4);
+  assert(bitset_popcount(&a) == 0);
+  assert(bitset_find_set(&a, 0) == 100);
+  assert(bitset_find_clear(&a, 99) == 99);
+
+  bitset_set(&a, 0);
+  bitset_set(&a, 31);
+  bitset_set(&a, 32);
+  bitset_set(&a, 99);
+  assert(bitset_test(&a, 31) && !bitset_test(&a, 30));
+  assert(bitset_popcount(&a) == 4);
+
+  /* Iterate the set bits */
+  n = 0;
+  for (i = bitset_find_set(&a, 0); i < a.count; i = bitset_find_set(&a, i + 1))
+  {
+    n += i;
+  }
+  assert(n == 0 + 31 + 32 + 99);
+  assert(bitset_find_set(&a, 33) == 99);
+  bitset_clear(&a, 99);
+  bitset_toggle(&a, 0);
+  assert(bitset_find_set(&a, 33) == 100 && bitset_find_set(&a, 0) == 31);
+
+  /* Ranges spanning one and several words */
+  bitset_set_range(&b, 3, 2);
+  assert(words_b[0] == 0x18);
+  bitset_set_range(&b, 30, 70);
+  assert(bitset_popcount(&b) == 72);
+  assert(words_b[0] == 0xC0000018 && words_b[1] == 0xFFFFFFFF && words_b[3] == 0xF);
+  assert(bitset_find_clear(&b, 30) == 100);
+  bitset_clear_range(&b, 33, 64);
+  assert(words_b[1] == 0x1 && words_b[2] == 0 && words_b[3] == 0xE);
+  assert(bitset_find_clear(&b, 30) == 33 && bitset_find_set(&b, 33) == 97);
+
+  /* Bulk operations, result aliasing an operand */
+  bitset_or(&a, &a, &b);
+  assert(bitset_popcount(&a) == 8);
+  bitset_andnot(&a, &a, &b);
+  assert(bitset_popcount(&a) == 0);
+  bitset_set(&a, 3);
+  bitset_set(&a, 5);
+  bitset_and(&a, &a, &b);
+  assert(bitset_popcount(&a) == 1 && bitset_test(&a, 3));
+}
+
+void types_test_overflow(void)
+{
+  u8 r8;
+  i16 r16;
+  u32 r32;
+  i32 s32;
+  u64 r64;
+  i64 s64;
+  i64 i64_max = i64_make(I32_MAX, 0xFFFFFFFF);
+  i64 i64_min = i64_make(I32_MIN, 0);
+
+  assert(u8_add_overflow(200, 56, &r8) && r8 == 0);
+  assert(!u8_add_overflow(200, 55, &r8) && r8 == 255);
+  assert(u8_sub_overflow(1, 2, &r8) && r8 == 255);
+  assert(u8_mul_overflow(16, 16, &r8) && r8 == 0);
+  assert(u8_add_sat(200, 100) == 255 && u8_sub_sat(5, 6) == 0 && u8_mul_sat(15, 17) == 255);
+  assert(u16_mul_sat(256, 256) == U16_MAX && u16_sub_sat(7, 3) == 4);
+  assert(i8_add_sat(100, 100) == I8_MAX && i8_sub_sat(-100, 100) == I8_MIN);
+  assert(i8_mul_sat(-16, 8) == I8_MIN && !i8_mul_overflow(-16, 8, (i8 *)&r8));
+  assert(i16_mul_overflow(-256, 256, &r16) && r16 == 0);
+  assert(i16_add_sat(-20000, -20000) == I16_MIN && i16_mul_sat(-200, -200) == I16_MAX);
+
+  assert(u32_add_overflow(0xFFFFFFFF, 1, &r32) && r32 == 0);
+  assert(u32_mul_overflow(0x10000, 0x10000, &r32) && r32 == 0);
+  assert(!u32_mul_overflow(0xFFFF, 0x10001, &r32) && r32 == 0xFFFFFFFF);
+  assert(u32_add_sat(0xFFFFFFF0, 0x20) == U32_MAX && u32_sub_sat(1, 2) == 0);
+  assert(i32_add_overflow(I32_MAX, 1, &s32) && s32 == I32_MIN);
+  assert(i32_sub_overflow(I32_MIN, 1, &s32) && s32 == I32_MAX);
+  assert(!i32_mul_overflow(-65536, 32768, &s32) && s32 == I32_MIN);
+  assert(i32_mul_sat(65536, 32768) == I32_MAX && i32_mul_sat(-65536, 65536) == I32_MIN);
+  assert(i32_add_sat(-5, 3) == -2);
+
+  assert(u64_add_overflow(u64_make(0xFFFFFFFF, 0xFFFFFFFF), u64_make(0, 1), &r64) && u64_eq(r64, u64_make(0, 0)));
+  assert(!u64_add_overflow(u64_make(0xFFFFFFFE, 0xFFFFFFFF), u64_make(0, 1), &r64) && u64_eq(r64, u64_make(0xFFFFFFFF, 0)));
+  assert(u64_sub_overflow(u64_make(1, 0), u64_make(1, 1), &r64) && u64_eq(r64, u64_make(0xFFFFFFFF, 0xFFFFFFFF)));
+  assert(u64_mul_overflow(u64_make(1, 0), u64_make(1, 0), &r64) && u64_eq(r64, u64_make(0, 0)));
+  assert(!u64_mul_overflow(u64_make(0, 0xFFFFFFFF), u64_make(1, 1), &r64) && u64_eq(r64, u64_make(0xFFFFFFFF, 0xFFFFFFFF)));
+  assert(u64_mul_overflow(u64_make(0, 0xFFFFFFFF), u64_make(1, 2), &r64));
+  assert(u64_eq(u64_add_sat(u64_make(0xFFFFFFFF, 0), u64_make(1, 0)), u64_make(0xFFFFFFFF, 0xFFFFFFFF)));
+  assert(u64_eq(u64_sub_sat(u64_make(0, 5), u64_make(0, 6)), u64_make(0, 0)));
+  assert(u64_eq(u64_mul_sat(u64_make(0, 3), u64_make(0, 5)), u64_make(0, 15)));
+
+  assert(i64_add_overflow(i64_max, i64_make(0, 1), &s64) && i64_eq(s64, i64_min));
+  assert(i64_sub_overflow(i64_min, i64_make(0, 1), &s64) && i64_eq(s64, i64_max));
+  assert(!i64_mul_overflow(i64_make(-1, 0), i64_make(0, 0x80000000), &s64) && i64_eq(s64, i64_min));
+  assert(i64_mul_overflow(i64_make(1, 0), i64_make(0, 0x80000000), &s64));
+  assert(i64_mul_overflow(i64_min, i64_make(-1, 0xFFFFFFFF), &s64) && i64_eq(s64, i64_min));
+  assert(i64_eq(i64_add_sat(i64_max, i64_max), i64_max));
+  assert(i64_eq(i64_sub_sat(i64_min, i64_make(0, 1)), i64_min));
+  assert(i64_eq(i64_mul_sat(i64_min, i64_make(-1, 0xFFFFFFFF)), i64_max));
+  assert(i64_eq(i64_mul_sat(i64_make(-2, 0), i64_make(0, 7)), i64_make(-14, 0)));
+}
+
+void types_test_fixed_point(void)
+{
+  q16_16 half = Q16_16_ONE / 2;
+  q16_16 three = q16_16_from_i32(3);
+  q16_16 minus_one_half = -(Q16_16_ONE + half);
+  q32_32 q3 = q32_32_from_i32(3);
+  q32_32 q_half = i64_make(0, 0x80000000);
+
+  assert(three == 0x30000);
+  assert(q16_16_to_i32(minus_one_half) == -2 && q16_16_to_i32_round(minus_one_half) == -1);
+  assert(q16_16_to_i32_round(three + half) == 4);
+  assert(q16_16_from_f32(0.25f) == 0x4000 && q16_16_from_f32(-0.25f) == -0x4000);
+  assert(q16_16_from_f32(1e10f) == Q16_16_MAX);
+  assert(q16_16_to_f32(minus_one_half) == -1.5f);
+
+  assert(q16_16_add(three, half) == 0x38000 && q16_16_sub(half, three) == -0x28000);
+  assert(q16_16_add_sat(Q16_16_MAX, three) == Q16_16_MAX);
+  assert(q16_16_mul(three, minus_one_half) == q16_16_from_i32(-5) + half);
+  assert(q16_16_mul(1, half) == 0 && q16_16_mul_round(1, half) == 1);
+  assert(q16_16_mul(-1, half) == -1 && q16_16_mul_round(-1, half) == 0);
+  assert(q16_16_mul_sat(q16_16_from_i32(300), q16_16_from_i32(300)) == Q16_16_MAX);
+  assert(q16_16_mul_sat(q16_16_from_i32(-300), q16_16_from_i32(300)) == Q16_16_MIN);
+  assert(q16_16_div(Q16_16_ONE, three) == 0x5555);
+  assert(q16_16_div(q16_16_from_i32(-9), three) == q16_16_from_i32(-3));
+  assert(q16_16_div(q16_16_from_i32(20000), half) == Q16_16_MAX);
+  assert(q16_16_div(-Q16_16_ONE, 0) == Q16_16_MIN);
+  assert(q16_16_recip(half) == q16_16_from_i32(2));
+
+  assert(q32_32_to_i32(q3) == 3 && q32_32_to_i32_round(i64_add(q3, q_half)) == 4);
+  assert(q32_32_to_i32(i64_neg(q_half)) == -1 && q32_32_to_i32_round(i64_neg(q_half)) == 0);
+  assert(q32_32_to_q16_16(q32_32_from_q16_16(minus_one_half)) == minus_one_half);
+  assert(i64_eq(q32_32_from_f32(-0.5f), i64_make(-1, 0x80000000)));
+  assert(q32_32_to_f32(i64_make(-2, 0x40000000)) == -1.75f);
+
+  assert(i64_eq(q32_32_mul(q3, q_half), i64_make(1, 0x80000000)));
+  assert(i64_eq(q32_32_mul(i64_make(0, 1), q_half), i64_make(0, 0)));
+  assert(i64_eq(q32_32_mul_round(i64_make(0, 1), q_half), i64_make(0, 1)));
+  assert(i64_eq(q32_32_mul_sat(q32_32_from_i32(I32_MIN), q32_32_from_i32(-1)), i64_make(I32_MAX, 0xFFFFFFFF)));
+  assert(i64_eq(q32_32_mul_sat(q32_32_from_i32(I32_MIN), q32_32_from_i32(1)), q32_32_from_i32(I32_MIN)));
+  assert(i64_eq(q32_32_sub_sat(q32_32_from_i32(I32_MIN), q3), i64_make(I32_MIN, 0)));
+  assert(i64_eq(q32_32_div(q32_32_from_i32(1), q3), i64_make(0, 0x55555555)));
+  assert(i64_eq(q32_32_div(q32_32_from_i32(-7), q_half), q32_32_from_i32(-14)));
+  assert(i64_eq(q32_32_div(i64_make(1000, 0), i64_make(0, 1)), i64_make(I32_MAX, 0xFFFFFFFF)));
+  assert(i64_eq(q32_32_recip(q_half), q32_32_from_i32(2)));
+  assert(i64_eq(q32_32_add(q3, q_half), i64_make(3, 0x80000000)));
+}
+
+void types_test_hash(void)
+{
+  u8 buffer[100];
+  u32 i;
+
+  for (i = 0; i < 100; ++i)
+  {
+    buffer[i] = (u8)(i * 131 + 7);
+  }
+
+  /* Reference values, identical in native and emulated mode */
+  assert(u64_eq(u64_hash_bytes(buffer, 0, u64_make(0, 0)), u64_make(0x93228A4D, 0xE0EEC5A2)));
+  assert(u64_eq(u64_hash_bytes(buffer, 3, u64_make(0, 0)), u64_make(0x2CB96FB6, 0x80F039D3)));
+  assert(u64_eq(u64_hash_bytes(buffer, 8, u64_make(0, 0)), u64_make(0xA50955DC, 0xEC919A0D)));
+  assert(u64_eq(u64_hash_bytes(buffer, 17, u64_make(0, 0)), u64_make(0x352601C4, 0xB5EB6031)));
+  assert(u64_eq(u64_hash_bytes(buffer, 49, u64_make(0, 0)), u64_make(0xF4E347C5, 0xBD40EB16)));
+  assert(u64_eq(u64_hash_bytes(buffer, 100, u64_make(0x12345678, 0x90ABCDEF)), u64_make(0xF8D6E3FD, 0x35FEF605)));
+  assert(!u64_eq(u64_hash_bytes(buffer, 100, u64_make(0, 0)), u64_hash_bytes(buffer, 99, u64_make(0, 0))));
+
+  assert(u64_eq(u64_hash_splitmix(u64_make(0, 0)), u64_make(0, 0)));
+  assert(u64_eq(u64_hash_splitmix(u64_make(0, 1)), u64_make(0x5692161D, 0x100B05E5)));
+  assert(u64_eq(u64_hash_murmur(u64_make(0, 1)), u64_make(0xB456BCFC, 0x34C2CB2C)));
+  assert(u32_hash_murmur(1) == 0x514E28B7);
+}
+
+void types_test_rng(void)
+{
+  rng_splitmix64 sm = rng_splitmix64_make(u64_make(0, 0));
+  rng_xoshiro256 x = rng_xoshiro256_make(u64_make(0, 42));
+  rng_xoshiro256 x2 = x;
+  rng_pcg32 p = rng_pcg32_make(u64_make(0, 42), u64_make(0, 54));
+  rng_pcg32 p2 = p;
+  u64 values[3];
+  u32 words[3];
+  u32 i;
+  b32 in_range = true;
+
+  assert(u64_eq(rng_splitmix64_next(&sm), u64_make(0xE220A839, 0x7B1DCDAF)));
+
+  assert(u64_eq(rng_xoshiro256_next(&x), u64_make(0x15780B2E, 0x0C2EC716)));
+  assert(u64_eq(rng_xoshiro256_next(&x), u64_make(0x6104D986, 0x6D113A7E)));
+  rng_xoshiro256_jump(&x);
+  assert(u64_eq(rng_xoshiro256_next(&x), u64_make(0x5EA1247B, 0x4DC6452A)));
+
+  /* Bulk fill continues the same sequence */
+  rng_xoshiro256_fill_u64(&x2, values, 2);
+  assert(u64_eq(values[1], u64_make(0x6104D986, 0x6D113A7E)));
+  x2 = rng_xoshiro256_make(u64_make(0, 42));
+  rng_xoshiro256_fill_u32(&x2, words, 3);
+  assert(words[0] == 0x15780B2E && words[1] == 0x0C2EC716 && words[2] == 0x6104D986);
+
+  /* Reference output of the PCG32 demo (seed 42, stream 54) */
+  assert(rng_pcg32_next(&p) == 0xA15C02B7);
+  assert(rng_pcg32_next(&p) == 0x7B47F409);
+  assert(rng_pcg32_next(&p) == 0xBA1D3330);
+  rng_pcg32_advance(&p2, u64_make(0, 2));
+  assert(rng_pcg32_next(&p2) == 0xBA1D3330);
+  rng_pcg32_fill_u64(&p2, values, 1);
+  assert(u64_eq(values[0], u64_make(0x83D2F293, 0xBFA4784B)));
+  rng_pcg32_fill_u32(&p2, words, 1);
+  assert(words[0] == 0xCBED606E);
+
+  for (i = 0; i < 1000; ++i)
+  {
+    u32 d = rng_pcg32_bounded(&p, 6);
+    u64 big = rng_xoshiro256_bounded(&x, u64_make(3, 0));
+    f32 f = rng_pcg32_f32(&p);
+    f64 g = rng_xoshiro256_f64(&x);
+    in_range &= (d < 6) & u64_lt(big, u64_make(3, 0)) & (f >= 0.0f) & (f < 1.0f) & (g >= 0.0) & (g < 1.0);
+  }
+  assert(in_range);
+  assert(rng_f32_from_u32(U32_MAX) < 1.0f && rng_f64_from_u64(u64_make(U32_MAX, U32_MAX)) < 1.0);
+}
+
+void types_test_arena(void)
+{
+  static u8 memory[64];
+  arena a = arena_make(memory, sizeof(memory));
+  arena_marker scratch;
+  u8 *bytes;
+  u32 *words;
+  f64 *doubles;
+
+  assert(TYPES_ALIGNOF(u8) == 1 && TYPES_ALIGNOF(u32) == 4);
+
+  bytes = ARENA_PUSH_ARRAY(&a, u8, 3);
+  words = ARENA_PUSH_ARRAY_ZERO(&a, u32, 2);
+  assert(bytes == memory);
+  assert(words != 0 && ((u32)(types_uptr)words & 3) == 0 && words[0] == 0 && words[1] == 0);
+  assert((u8 *)words - memory >= 3);
+
+  scratch = arena_save(&a);
+  doubles = ARENA_PUSH_ARRAY(&a, f64, 4);
+  assert(doubles != 0 && ((u32)(types_uptr)doubles & (TYPES_ALIGNOF(f64) - 1)) == 0);
+  assert(ARENA_PUSH_ARRAY(&a, u8, arena_remaining(&a) + 1) == 0);
+  assert(ARENA_PUSH_ARRAY(&a, u32, 0x40000001U) == 0 && ARENA_PUSH_ARRAY_ZERO(&a, u32, 0x40000001U) == 0);
+  assert(arena_push_array(&a, 0x10000U, 0x10000U, 1) == 0 && arena_push_array(&a, 0, 1, 1) == 0);
+  arena_restore(&a, scratch);
+  assert(ARENA_PUSH_STRUCT(&a, f64) == doubles);
+
+  arena_reset(&a);
+  assert(arena_remaining(&a) == 64);
+  assert(arena_push(&a, 64, 1) == memory && arena_push(&a, 1, 1) == 0);
+#ifdef TYPES_ARENA_STATS
+  assert(arena_high_water(&a) == 64);
+#endif
+}
+
+void types_test_memory(void)
+{
+  static u8 src[300];
+  static u8 dst[300];
+  static u8 ref[300];
+  b32 copy_ok = 1;
+  b32 set_ok = 1;
+  b32 chr_ok = 1;
+  b32 cmp_ok = 1;
+  b32 move_ok = 1;
+  u32 offset;
+  u32 size;
+  u32 i;
+  struct
+  {
+    u32 a;
+    u64 b;
+  } s0, s1;
+
+  for (i = 0; i < 300; ++i)
+  {
+    src[i] = (u8)(i * 7 + 1);
+  }
+
+  /* All head alignments and sizes around the word and register widths */
+  for (offset = 0; offset < 16; ++offset)
+  {
+    for (size = 0; size < 80; ++size)
+    {
+      for (i = 0; i < 300; ++i)
+      {
+        dst[i] = 0xAA;
+        ref[i] = 0xAA;
+      }
+      for (i = 0; i < size; ++i)
+      {
+        ref[offset + i] = src[i + 3];
+      }
+      copy_ok &= types_memcpy(dst + offset, src + 3, size) == dst + offset;
+      copy_ok &= types_memcmp(dst, ref, 300) == 0;
+
+      for (i = 0; i < size; ++i)
+      {
+        ref[offset + i] = 0x5C;
+      }
+      set_ok &= types_memset(dst + offset, 0x5C, size) == dst + offset;
+      set_ok &= types_memcmp(dst, ref, 300) == 0;
+
+      /* memchr finds the first match only inside the range */
+      if (size > 0)
+      {
+        ref[offset + size - 1] = 0x11;
+        chr_ok &= types_memchr(ref + offset, 0x11, size) == ref + offset + size - 1;
+        chr_ok &= types_memchr(ref + offset, 0x11, size - 1) == 0;
+        ref[offset + size / 2] = 0x11;
+        chr_ok &= types_memchr(ref + offset, 0x11, size) == ref + offset + size / 2;
+
+        /* memcmp orders by the first differing byte */
+        cmp_ok &= types_memcmp(ref + offset, dst + offset, size) < 0;
+        cmp_ok &= types_memcmp(dst + offset, ref + offset, size) > 0;
+        cmp_ok &= types_memcmp(dst + offset, ref + offset, size / 2) == 0;
+      }
+    }
+  }
+
+  /* Overlapping moves in both directions */
+  for (offset = 0; offset < 40; ++offset)
+  {
+    for (i = 0; i < 300; ++i)
+    {
+      dst[i] = src[i];
+      ref[i] = src[i];
+    }
+    types_memmove(dst + offset, dst + 5, 200);
+    types_memmove(ref + 100, ref + 100 - offset, 150);
+    for (i = 0; i < 200; ++i)
+    {
+      move_ok &= dst[offset + i] == src[5 + i];
+    }
+    for (i = 0; i < 150; ++i)
+    {
+      move_ok &= ref[100 + i] == src[100 - offset + i];
+    }
+  }
+
+  assert(copy_ok);
+  assert(set_ok);
+  assert(chr_ok);
+  assert(cmp_ok);
+  assert(move_ok);
+  assert(types_memcmp("abc", "abd", 3) < 0);
+  assert(types_memcmp("abc", "abc", 0) == 0);
+  assert(types_memchr("abc", 'x', 3) == 0);
+
+  TYPES_MEMSET(&s0, 0, sizeof(s0));
+  s0.a = 7;
+  s0.b = u64_make(1, 2);
+  TYPES_MEMCPY(&s1, &s0, sizeof(s0));
+  assert(TYPES_MEMCMP(&s0, &s1, sizeof(s0)) == 0);
+  TYPES_MEMCPY(dst, src, 65);
+  TYPES_MEMMOVE(dst + 1, dst, 64);
+  assert(dst[1] == src[0] && dst[64] == src[63]);
+}
+
+void types_test_endian(void)
+{
+  u8 bytes[11] = {0xFF, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFF, 0xFF};
+  u8 out[10] = {0};
+  u16 halves[2];
+  u32 words[2];
+  u64 longs[2];
+
+  /* Unaligned reads at offset 1 */
+  assert(u16_load_le(bytes + 1) == 0x2301);
+  assert(u16_load_be(bytes + 1) == 0x0123);
+  assert(u32_load_le(bytes + 1) == 0x67452301);
+  assert(u32_load_be(bytes + 1) == 0x01234567);
+  assert(u64_eq(u64_load_le(bytes + 1), u64_make(0xEFCDAB89, 0x67452301)));
+  assert(u64_eq(u64_load_be(bytes + 1), u64_make(0x01234567, 0x89ABCDEF)));
+
+  u16_store_le(out + 1, 0x2301);
+  assert(out[0] == 0 && out[1] == 0x01 && out[2] == 0x23 && out[3] == 0);
+  u16_store_be(out + 1, 0x0123);
+  assert(out[1] == 0x01 && out[2] == 0x23);
+  u32_store_le(out + 1, 0x67452301);
+  assert(u32_load_be(out + 1) == 0x01234567 && out[5] == 0);
+  u32_store_be(out + 1, 0x01234567);
+  assert(u32_load_le(out + 1) == 0x67452301);
+  u64_store_le(out + 1, u64_make(0xEFCDAB89, 0x67452301));
+  assert(out[1] == 0x01 && out[8] == 0xEF && out[9] == 0);
+  u64_store_be(out + 1, u64_make(0x01234567, 0x89ABCDEF));
+  assert(u64_eq(u64_load_le(out + 1), u64_make(0xEFCDAB89, 0x67452301)));
+
+  halves[0] = 0x0123;
+  halves[1] = 0xABCD;
+  words[0] = 0x01234567;
+  words[1] = 0x89ABCDEF;
+  longs[0] = u64_make(0x01234567, 0x89ABCDEF);
+  longs[1] = u64_make(0, 0xFF);
+  u16_bswap_n(halves, 2);
+  u32_bswap_n(words, 2);
+  u64_bswap_n(longs, 2);
+  assert(halves[0] == 0x2301 && halves[1] == 0xCDAB);
+  assert(words[0] == 0x67452301 && words[1] == 0xEFCDAB89);
+  assert(u64_eq(longs[0], u64_make(0xEFCDAB89, 0x67452301)));
+  assert(u64_eq(longs[1], u64_make(0xFF000000, 0)));
+}
+
+void types_test_varint(void)
+{
+  static u32 values[203];
+  static u32 decoded[203];
+  static u8 stream[STREAMVBYTE_MAX_BYTES(203)];
+  static const u8 overlong32[6] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+  static const u8 overlong64[10] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+  rng_xoshiro256 rng = rng_xoshiro256_make(u64_make(0, 7));
+  u8 buffer[U64_LEB128_MAX_BYTES];
+  b32 leb_ok = 1;
+  b32 svb_ok = 1;
+  u32 count;
+  u32 size;
+  u32 u = 0;
+  i32 s = 0;
+  u64 u64v = u64_make(0, 0);
+  i64 i64v;
+  u32 i;
+
+  assert(i32_zigzag_encode(0) == 0 && i32_zigzag_encode(-1) == 1 && i32_zigzag_encode(1) == 2);
+  assert(i32_zigzag_encode(-2147483647 - 1) == 0xFFFFFFFF && i32_zigzag_decode(0xFFFFFFFE) == 2147483647);
+  assert(u64_eq(i64_zigzag_encode(i64_make(-1, 0xFFFFFFFF)), u64_make(0, 1)));
+  assert(u64_eq(i64_zigzag_encode(i64_make(0, 0x80000000)), u64_make(1, 0)));
+  assert(i64_eq(i64_zigzag_decode(u64_make(0xFFFFFFFF, 0xFFFFFFFF)), i64_make((i32)0x80000000, 0)));
+
+  /* Reference encodings (DWARF spec) */
+  assert(u32_uleb128_encode(buffer, 624485) == 3 && buffer[0] == 0xE5 && buffer[1] == 0x8E && buffer[2] == 0x26);
+  assert(i32_sleb128_encode(buffer, -123456) == 3 && buffer[0] == 0xC0 && buffer[1] == 0xBB && buffer[2] == 0x78);
+  assert(i32_sleb128_decode(buffer, 3, &s) == 3 && s == -123456);
+  assert(i32_sleb128_encode(buffer, 63) == 1 && i32_sleb128_encode(buffer, 64) == 2 && i32_sleb128_encode(buffer, -64) == 1);
+  assert(u64_uleb128_encode(buffer, u64_make(0xFFFFFFFF, 0xFFFFFFFF)) == 10 && buffer[9] == 0x01);
+
+  /* Truncated and overlong input */
+  assert(u32_uleb128_decode(buffer, 2, &u) == 0);
+  assert(u32_uleb128_decode(overlong32, 6, &u) == 0);
+  assert(u32_uleb128_decode(overlong64, 5, &u) == 0);
+  assert(u64_uleb128_decode(overlong64, 10, &u64v) == 0);
+  assert(u64_uleb128_decode(overlong64, 9, &u64v) == 0);
+
+  for (i = 0; i < 2000; ++i)
+  {
+    u64 r = rng_xoshiro256_next(&rng);
+    /* Spread the magnitudes over all encoded lengths */
+    u64 x = u64_shr(r, (int)(u64_low(r) & 63));
+    u64 back = u64_make(0, 0);
+    i64 sback = i64_make(0, 0);
+    u32 n;
+
+    u = u64_low(x);
+    n = u32_uleb128_encode(buffer, u);
+    leb_ok &= n <= U32_LEB128_MAX_BYTES && u32_uleb128_decode(buffer, n, &decoded[0]) == n && decoded[0] == u;
+    leb_ok &= u32_uleb128_decode(buffer, U64_LEB128_MAX_BYTES, &decoded[0]) == n && decoded[0] == u;
+    n = i32_sleb128_encode(buffer, (i32)u);
+    leb_ok &= n <= U32_LEB128_MAX_BYTES && i32_sleb128_decode(buffer, n, &s) == n && s == (i32)u;
+    n = u64_uleb128_encode(buffer, x);
+    leb_ok &= u64_uleb128_decode(buffer, n, &back) == n && u64_eq(back, x);
+    leb_ok &= u64_uleb128_decode(buffer, n - 1, &back) == 0;
+    /* Room for the word loads of the fast path */
+    leb_ok &= u64_uleb128_decode(buffer, U64_LEB128_MAX_BYTES, &back) == n && u64_eq(back, x);
+    n = i64_sleb128_encode(buffer, i64_from_u64(x));
+    leb_ok &= n <= U64_LEB128_MAX_BYTES && i64_sleb128_decode(buffer, n, &sback) == n && i64_eq(sback, i64_from_u64(x));
+    i64v = i64_zigzag_decode(i64_zigzag_encode(i64_from_u64(x)));
+    leb_ok &= i64_eq(i64v, i64_from_u64(x));
+    leb_ok &= i32_zigzag_decode(i32_zigzag_encode((i32)u)) == (i32)u;
+  }
+  assert(leb_ok);
+
+  size = 0;
+  for (i = 0; i < 3; ++i)
+  {
+    size += u64_uleb128_encode(stream + size, u64_make(i, i * 300));
+  }
+  assert(u64_uleb128_decode_n(&u64v, 1, stream, size) == 1);
+  {
+    u64 three[3];
+    assert(u64_uleb128_decode_n(three, 3, stream, size) == size);
+    assert(u64_eq(three[0], u64_make(0, 0)) && u64_eq(three[2], u64_make(2, 600)));
+    assert(u64_uleb128_decode_n(three, 3, stream, size - 1) == 0);
+  }
+
+  /* Every count exercises a different split between the fast and tail loop */
+  for (count = 0; count <= 203; count += 7)
+  {
+    for (i = 0; i < count; ++i)
+    {
+      u64 r = rng_xoshiro256_next(&rng);
+      values[i] = u64_high(r) >> ((u64_low(r) & 3) * 8);
+      decoded[i] = 0xDEADBEEF;
+    }
+    size = u32_streamvbyte_encode(stream, values, count);
+    svb_ok &= size <= STREAMVBYTE_MAX_BYTES(count);
+    svb_ok &= u32_streamvbyte_decode(decoded, count, stream, size) == size;
+    for (i = 0; i < count; ++i)
+    {
+      svb_ok &= decoded[i] == values[i];
+    }
+    svb_ok &= count == 0 || u32_streamvbyte_decode(decoded, count, stream, size - 1) == 0;
+  }
+  assert(svb_ok);
+}
+
+static b32 types_test_chars(const char *a, u32 length, const char *expected)
+{
+  u32 i;
+  for (i = 0; i < length; ++i)
+  {
+    if (expected[i] != a[i])
+    {
+      return 0;
+    }
+  }
+  return expected[length] == 0;
+}
+
+void types_test_format(void)
+{
+  char s[I64_DEC_MAX_CHARS];
+  rng_xoshiro256 rng = rng_xoshiro256_make(u64_make(0, 11));
+  b32 dec_ok = 1;
+  u32 i;
+
+  assert(types_test_chars(s, u32_to_dec(s, 0), "0"));
+  assert(types_test_chars(s, u32_to_dec(s, 9), "9"));
+  assert(types_test_chars(s, u32_to_dec(s, 10), "10"));
+  assert(types_test_chars(s, u32_to_dec(s, 1000000000), "1000000000"));
+  assert(types_test_chars(s, u32_to_dec(s, 4294967295U), "4294967295"));
+  assert(types_test_chars(s, i32_to_dec(s, -7), "-7"));
+  assert(types_test_chars(s, i32_to_dec(s, I32_MIN), "-2147483648"));
+
+  assert(types_test_chars(s, u64_to_dec(s, u64_make(0, 123)), "123"));
+  assert(types_test_chars(s, u64_to_dec(s, u64_make(1, 0)), "4294967296"));
+  assert(types_test_chars(s, u64_to_dec(s, u64_make(0xDE0B6B3, 0xA7640000)), "1000000000000000000"));
+  assert(types_test_chars(s, u64_to_dec(s, u64_make(0xDE0B6B3, 0xA763FFFF)), "999999999999999999"));
+  assert(types_test_chars(s, u64_to_dec(s, u64_make(0x3B9ACA00, 0)), "4294967296000000000"));
+  assert(types_test_chars(s, u64_to_dec(s, u64_make(0xFFFFFFFF, 0xFFFFFFFF)), "18446744073709551615"));
+  assert(types_test_chars(s, i64_to_dec(s, i64_make(-1, 0xFFFFFFFF)), "-1"));
+  assert(types_test_chars(s, i64_to_dec(s, i64_make((i32)0x80000000, 0)), "-9223372036854775808"));
+  assert(types_test_chars(s, i64_to_dec(s, i64_make(0x7FFFFFFF, 0xFFFFFFFF)), "9223372036854775807"));
+
+  assert(types_test_chars(s, u32_to_hex(s, 0), "0"));
+  assert(types_test_chars(s, u32_to_hex(s, 0xABC), "abc"));
+  assert(types_test_chars(s, u32_to_hex(s, 0xFFFFFFFF), "ffffffff"));
+  assert(types_test_chars(s, u64_to_hex(s, u64_make(0x1, 0x0000BEEF)), "10000beef"));
+  assert(types_test_chars(s, u64_to_hex(s, u64_make(0x01234567, 0x89ABCDEF)), "123456789abcdef"));
+
+  /* Digit count and round trip through the digits for random magnitudes */
+  for (i = 0; i < 1000; ++i)
+  {
+    u64 r = rng_xoshiro256_next(&rng);
+    u64 x = u64_shr(r, (int)(u64_low(r) & 63));
+    u64 back = u64_make(0, 0);
+    u32 n = u64_to_dec(s, x);
+    u32 j;
+    for (j = 0; j < n; ++j)
+    {
+      back = u64_add_u32(u64_mul_u32(back, 10), (u32)(s[j] - '0'));
+    }
+    dec_ok &= u64_eq(back, x) && (n == 1 || s[0] != '0');
+    dec_ok &= u32_dec_length(u64_low(x)) == u32_to_dec(s, u64_low(x));
+  }
+  assert(dec_ok);
+}
+
+static u32 types_test_length(const char *s)
+{
+  u32 n = 0;
+  while (s[n])
+  {
+    ++n;
+  }
+  return n;
+}
+
+#define TYPES_TEST_PARSE(fn, text, value) fn((const u8 *)(text), types_test_length(text), (value))
+
+void types_test_parse(void)
+{
+  char s[U64_DEC_MAX_CHARS + 8];
+  rng_xoshiro256 rng = rng_xoshiro256_make(u64_make(0, 13));
+  b32 dec_ok = 1;
+  b32 hex_ok = 1;
+  u32 u = 0;
+  i32 i32v = 0;
+  u64 u64v = u64_make(0, 0);
+  i64 i64v = i64_make(0, 0);
+  u32 i;
+
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "0", &u) == 1 && u == 0);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "123 456", &u) == 3 && u == 123);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "4294967295,", &u) == 10 && u == 4294967295U);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "4294967296", &u) == 0);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "00000000000000004294967295", &u) == 26 && u == 4294967295U);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "x1", &u) == 0);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "", &u) == 0);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "12345678:", &u) == 8 && u == 12345678);
+  assert(TYPES_TEST_PARSE(u32_parse_dec, "1234/678", &u) == 4 && u == 1234);
+
+  assert(TYPES_TEST_PARSE(i32_parse_dec, "-2147483648", &i32v) == 11 && i32v == I32_MIN);
+  assert(TYPES_TEST_PARSE(i32_parse_dec, "+2147483647", &i32v) == 11 && i32v == I32_MAX);
+  assert(TYPES_TEST_PARSE(i32_parse_dec, "2147483648", &i32v) == 0);
+  assert(TYPES_TEST_PARSE(i32_parse_dec, "-", &i32v) == 0);
+
+  assert(TYPES_TEST_PARSE(u64_parse_dec, "18446744073709551615", &u64v) == 20 && u64_eq(u64v, u64_make(0xFFFFFFFF, 0xFFFFFFFF)));
+  assert(TYPES_TEST_PARSE(u64_parse_dec, "18446744073709551616", &u64v) == 0);
+  assert(TYPES_TEST_PARSE(u64_parse_dec, "99999999999999999999", &u64v) == 0);
+  assert(TYPES_TEST_PARSE(u64_parse_dec, "4294967296 ", &u64v) == 10 && u64_eq(u64v, u64_make(1, 0)));
+  assert(TYPES_TEST_PARSE(i64_parse_dec, "-9223372036854775808", &i64v) == 20 && i64_eq(i64v, i64_make((i32)0x80000000, 0)));
+  assert(TYPES_TEST_PARSE(i64_parse_dec, "9223372036854775807", &i64v) == 19 && i64_eq(i64v, i64_make(I32_MAX, 0xFFFFFFFF)));
+  assert(TYPES_TEST_PARSE(i64_parse_dec, "9223372036854775808", &i64v) == 0);
+  assert(TYPES_TEST_PARSE(i64_parse_dec, "-1", &i64v) == 2 && i64_eq(i64v, i64_make(-1, 0xFFFFFFFF)));
+
+  assert(TYPES_TEST_PARSE(u32_parse_hex, "DeadBeef", &u) == 8 && u == 0xDEADBEEF);
+  assert(TYPES_TEST_PARSE(u32_parse_hex, "1fG", &u) == 2 && u == 0x1F);
+  assert(TYPES_TEST_PARSE(u32_parse_hex, "100000000", &u) == 0);
+  assert(TYPES_TEST_PARSE(u32_parse_hex, "00000000ffffffff", &u) == 16 && u == 0xFFFFFFFF);
+  assert(TYPES_TEST_PARSE(u32_parse_hex, "g", &u) == 0);
+  assert(TYPES_TEST_PARSE(u32_parse_hex, "@`/:", &u) == 0);
+  assert(TYPES_TEST_PARSE(u64_parse_hex, "123456789abcdef0", &u64v) == 16 && u64_eq(u64v, u64_make(0x12345678, 0x9ABCDEF0)));
+  assert(TYPES_TEST_PARSE(u64_parse_hex, "ABCDEF012", &u64v) == 9 && u64_eq(u64v, u64_make(0xA, 0xBCDEF012)));
+  assert(TYPES_TEST_PARSE(u64_parse_hex, "1123456789abcdef0", &u64v) == 0);
+  assert(TYPES_TEST_PARSE(u64_parse_hex, "000000000000000000000001", &u64v) == 24 && u64_eq(u64v, u64_make(0, 1)));
+
+  /* Round trips through the formatting functions with trailing garbage */
+  for (i = 0; i < 2000; ++i)
+  {
+    u64 r = rng_xoshiro256_next(&rng);
+    u64 x = u64_shr(r, (int)(u64_low(r) & 63));
+    u32 n = u64_to_dec(s, x);
+    s[n] = (char)(' ' + (i & 15));
+    dec_ok &= u64_parse_dec((const u8 *)s, n + 1, &u64v) == n && u64_eq(u64v, x);
+    n = i64_to_dec(s, i64_from_u64(r));
+    dec_ok &= i64_parse_dec((const u8 *)s, n, &i64v) == n && i64_eq(i64v, i64_from_u64(r));
+    n = u32_to_dec(s, u64_low(x));
+    dec_ok &= u32_parse_dec((const u8 *)s, n, &u) == n && u == u64_low(x);
+    n = u64_to_hex(s, x);
+    s[n] = (char)('g' + (i & 7));
+    hex_ok &= u64_parse_hex((const u8 *)s, n + 1, &u64v) == n && u64_eq(u64v, x);
+    n = u32_to_hex(s, u64_high(x));
+    if (i & 1)
+    {
+      s[0] = (char)(s[0] >= 'a' ? s[0] - 32 : s[0]);
+    }
+    hex_ok &= u32_parse_hex((const u8 *)s, n, &u) == n && u == u64_high(x);
+  }
+  assert(dec_ok);
+  assert(hex_ok);
+}
+
+/* |x - y| is at most half of the last place of a float with the given significand bits */
+static b32 types_test_rounded(u64 x, u64 y, int significand)
+{
+  u64 diff = u64_lt(x, y) ? u64_sub(y, x) : u64_sub(x, y);
+  int dropped = 64 - u64_clz(x) - significand;
+  return dropped <= 0 ? u64_eq(diff, u64_make(0, 0)) : !u64_lt(u64_shl(u64_make(0, 1), dropped - 1), diff);
+}
+
+void types_test_float(void)
+{
+  rng_xoshiro256 rng = rng_xoshiro256_make(u64_make(0, 17));
+  f64 nan = f64_from_bits(u64_make(0x7FF80000, 0));
+  f64 inf = f64_from_bits(u64_make(0x7FF00000, 0));
+  f64 values[4];
+  i64 ints[4];
+  u64 uints[4];
+  f32 floats[4];
+  b32 ok = 1;
+  u32 i;
+
+  assert(f32_to_bits(1.0f) == 0x3F800000 && f32_from_bits(0xC0000000) == -2.0f);
+  assert(u64_eq(f64_to_bits(1.0), u64_make(0x3FF00000, 0)) && f64_from_bits(u64_make(0xC0080000, 0)) == -3.0);
+
+  /* Ties round to even above 2^53 */
+  assert(double_from_u64(u64_make(0x001FFFFF, 0xFFFFFFFF)) == 9007199254740991.0);
+  assert(double_from_u64(u64_make(0x00200000, 0x00000001)) == 9007199254740992.0);
+  assert(double_from_u64(u64_make(0x00200000, 0x00000003)) == 9007199254740996.0);
+  assert(double_from_u64(u64_make(0x80000000, 0x00000400)) == 9223372036854775808.0);
+  assert(double_from_u64(u64_make(0x80000000, 0x00000401)) == 9223372036854777856.0);
+  assert(double_from_u64(u64_make(0x80000000, 0x00000C00)) == 9223372036854779904.0);
+  assert(double_from_u64(u64_make(0xFFFFFFFF, 0xFFFFFFFF)) == 18446744073709551616.0);
+  assert(double_from_i64(i64_make(I32_MIN, 0)) == -9223372036854775808.0);
+
+  assert(f32_from_u64(u64_make(0, 16777217)) == 16777216.0f);
+  assert(f32_from_u64(u64_make(1, 0x80)) == 4294967296.0f);
+  assert(f32_from_u64(u64_make(0x01000001, 0)) == 72057594037927936.0f);
+  assert(f32_from_u64(u64_make(0x01000001, 1)) == 72057602627862528.0f);
+  assert(f32_from_u64(u64_make(0xFFFFFFFF, 0xFFFFFFFF)) == 18446744073709551616.0f);
+  assert(f32_from_i64(i64_make(-1, 0xFFFFFFFD)) == -3.0f);
+  assert(f32_from_i64(i64_make(I32_MIN, 0)) == -9223372036854775808.0f);
+
+  assert(u64_eq(u64_from_f64(4294967296.9), u64_make(1, 0)));
+  assert(u64_eq(u64_from_f64(0.999), u64_make(0, 0)) && u64_eq(u64_from_f64(-0.0), u64_make(0, 0)));
+  assert(u64_eq(u64_from_f64(18446744073709549568.0), u64_make(0xFFFFFFFF, 0xFFFFF800)));
+  assert(u64_eq(u64_from_f64(18446744073709551616.0), u64_make(0, 0)));
+  assert(u64_eq(u64_from_f64(-1.0), u64_make(0xFFFFFFFF, 0xFFFFFFFF)));
+  assert(u64_eq(u64_from_f64(nan), u64_make(0, 0)) && u64_eq(u64_from_f64(inf), u64_make(0, 0)));
+  assert(i64_eq(i64_from_f64(-2.9), i64_make(-1, 0xFFFFFFFE)));
+  assert(i64_eq(i64_from_f64(9223372036854775808.0), i64_make(I32_MIN, 0)));
+  assert(i64_eq(i64_from_f64(1e-300), i64_make(0, 0)));
+
+  assert(i64_eq(i64_from_f64_round(2.5), i64_make(0, 2)) && i64_eq(i64_from_f64_round(3.5), i64_make(0, 4)));
+  assert(i64_eq(i64_from_f64_round(-2.5), i64_make(-1, 0xFFFFFFFE)) && i64_eq(i64_from_f64_round(-2.51), i64_make(-1, 0xFFFFFFFD)));
+  assert(i64_eq(i64_from_f64_round(0.5), i64_make(0, 0)) && i64_eq(i64_from_f64_round(0.50000001), i64_make(0, 1)));
+  assert(u64_eq(u64_from_f64_round(4503599627370495.5), u64_make(0x00100000, 0)));
+  assert(u64_eq(u64_from_f64_round(4294967295.5), u64_make(1, 0)));
+
+  assert(u64_eq(u64_from_f64_sat(-1.0), u64_make(0, 0)) && u64_eq(u64_from_f64_sat(nan), u64_make(0, 0)));
+  assert(u64_eq(u64_from_f64_sat(1e30), u64_make(U32_MAX, U32_MAX)) && u64_eq(u64_from_f64_sat(inf), u64_make(U32_MAX, U32_MAX)));
+  assert(u64_eq(u64_from_f64_sat(18446744073709549568.0), u64_make(0xFFFFFFFF, 0xFFFFF800)));
+  assert(i64_eq(i64_from_f64_sat(1e19), i64_make(I32_MAX, U32_MAX)) && i64_eq(i64_from_f64_sat(-inf), i64_make(I32_MIN, 0)));
+  assert(i64_eq(i64_from_f64_sat(-9223372036854775808.0), i64_make(I32_MIN, 0)));
+  assert(i64_eq(i64_from_f64_sat(9223372036854774784.0), i64_make(0x7FFFFFFF, 0xFFFFFC00)));
+  assert(i64_eq(i64_from_f64_sat(-123.75), i64_make(-1, (u32)-123)) && i64_eq(i64_from_f64_sat(nan), i64_make(0, 0)));
+
+  /* Correctly rounded at every magnitude and exact on the way back */
+  for (i = 0; i < 4096; ++i)
+  {
+    u64 x = u64_shr(rng_xoshiro256_next(&rng), (int)(i & 63));
+    if (!u64_eq(x, u64_make(0, 0)) && u64_clz(x) > 0)
+    {
+      ok &= types_test_rounded(x, u64_from_f64(double_from_u64(x)), 53);
+      ok &= types_test_rounded(x, u64_from_f64((f64)f32_from_u64(x)), 24);
+    }
+    ok &= u64_eq(u64_from_f64(double_from_u64(u64_shr(x, 11))), u64_shr(x, 11));
+    ok &= i64_eq(i64_from_f64_round(double_from_i64(i64_from_u64(u64_shr(x, 11)))), i64_from_u64(u64_shr(x, 11)));
+  }
+  assert(ok);
+
+  values[0] = 1.5;
+  values[1] = -2.5;
+  values[2] = 1e300;
+  values[3] = nan;
+  i64_from_f64_n(ints, values, 4);
+  assert(i64_eq(ints[0], i64_make(0, 1)) && i64_eq(ints[1], i64_make(-1, 0xFFFFFFFE)) && i64_eq(ints[2], i64_make(0, 0)));
+  i64_from_f64_round_n(ints, values, 4);
+  assert(i64_eq(ints[0], i64_make(0, 2)) && i64_eq(ints[1], i64_make(-1, 0xFFFFFFFE)));
+  i64_from_f64_sat_n(ints, values, 4);
+  assert(i64_eq(ints[2], i64_make(I32_MAX, U32_MAX)) && i64_eq(ints[3], i64_make(0, 0)));
+  u64_from_f64_sat_n(uints, values, 4);
+  assert(u64_eq(uints[0], u64_make(0, 1)) && u64_eq(uints[1], u64_make(0, 0)));
+  double_from_i64_n(values, ints, 4);
+  assert(values[0] == 1.0 && values[1] == -2.0 && values[2] == 9223372036854775808.0 && values[3] == 0.0);
+  f32_from_u64_n(floats, uints, 4);
+  assert(floats[0] == 1.0f && floats[2] == 18446744073709551616.0f);
+}
+
+/* Distance of two finite f32 of the same sign in units of the last place */
+static u32 types_test_ulps(f32 a, f32 b)
+{
+  u32 x = f32_to_bits(a);
+  u32 y = f32_to_bits(b);
+  return x > y ? x - y : y - x;
+}
+
+void types_test_math(void)
+{
+  rng_pcg32 rng = rng_pcg32_make(u64_make(0, 23), u64_make(0, 5));
+  f32 inf = f32_from_bits(0x7F800000);
+  f32 nan = f32_from_bits(0x7FC00000);
+  f32 values[20];
+  f32 results[20];
+  b32 ok = 1;
+  u32 i;
+
+  assert(f32_sqrt(4.0f) == 2.0f && f32_sqrt(2.0f) == f32_from_bits(0x3FB504F3) && f32_sqrt(0.0f) == 0.0f);
+  assert(f32_to_bits(f32_sqrt(-0.0f)) == 0x80000000 && f32_sqrt(inf) == inf);
+  assert(f32_sqrt(-1.0f) != f32_sqrt(-1.0f) && f32_sqrt(nan) != f32_sqrt(nan));
+  assert(f32_sqrt(f32_from_bits(2)) == f32_from_bits(53U << 23));
+  assert(f32_rsqrt(4.0f) == 0.5f && f32_rsqrt(0.0f) == inf && f32_rsqrt(-0.0f) == -inf && f32_rsqrt(inf) == 0.0f);
+  assert(f32_rsqrt(-4.0f) != f32_rsqrt(-4.0f) && f32_rsqrt(f32_from_bits(2)) == f32_from_bits(201U << 23));
+  assert(f32_rsqrt_fast(4.0f) > 0.499f && f32_rsqrt_fast(4.0f) < 0.501f);
+
+  assert(f32_exp(0.0f) == 1.0f && types_test_ulps(f32_exp(1.0f), 2.71828183f) <= 1);
+  assert(types_test_ulps(f32_exp(-10.0f), 4.53999298e-5f) <= 1 && types_test_ulps(f32_exp(88.0f), 1.65163625e38f) <= 1);
+  assert(f32_exp(89.0f) == inf && f32_exp(inf) == inf && f32_exp(-inf) == 0.0f && f32_exp(-104.0f) == 0.0f);
+  assert(f32_exp(-100.0f) > 0.0f && f32_exp(-100.0f) < F32_MIN && f32_exp(nan) != f32_exp(nan));
+
+  assert(f32_log(1.0f) == 0.0f && types_test_ulps(f32_log(2.71828183f), 1.0f) <= 1);
+  assert(types_test_ulps(f32_log(F32_MAX), 88.7228394f) <= 1 && types_test_ulps(f32_log(f32_from_bits(1)), -103.278931f) <= 1);
+  assert(f32_log(0.0f) == -inf && f32_log(-0.0f) == -inf && f32_log(inf) == inf);
+  assert(f32_log(-1.0f) != f32_log(-1.0f) && f32_log(nan) != f32_log(nan));
+
+  assert(f32_sin(0.0f) == 0.0f && f32_cos(0.0f) == 1.0f);
+  assert(types_test_ulps(f32_sin(0.523598776f), 0.5f) <= 1 && types_test_ulps(f32_cos(1.04719755f), 0.5f) <= 1);
+  assert(types_test_ulps(f32_sin(-4.0f), 0.756802495f) <= 1 && types_test_ulps(f32_cos(-4.0f), -0.653643621f) <= 1);
+  assert(types_test_ulps(f32_cos(3.14159274f), -1.0f) <= 1 && types_test_ulps(f32_sin(100000.0f), 0.0357487984f) <= 1);
+  assert(f32_sin(inf) != f32_sin(inf) && f32_cos(-inf) != f32_cos(-inf) && f32_sin(nan) != f32_sin(nan));
+
+  /* From 2^28 on the reduction runs on the bits of 2/pi */
+  assert(types_test_ulps(f32_sin(268435456.0f), -0.986198187f) <= 1 && types_test_ulps(f32_cos(268435456.0f), -0.165568978f) <= 1);
+  assert(types_test_ulps(f32_sin(3e8f), -0.439552039f) <= 1 && types_test_ulps(f32_cos(1e9f), 0.837887168f) <= 1);
+  assert(types_test_ulps(f32_sin(-1e20f), -0.656576693f) <= 1 && types_test_ulps(f32_cos(-1e20f), 0.754259288f) <= 1);
+  assert(types_test_ulps(f32_sin(F32_MAX), -0.521876514f) <= 1 && types_test_ulps(f32_cos(-F32_MAX), 0.853021026f) <= 1);
+
+  /* Exact squares, identities and inverse functions */
+  for (i = 0; i < 4096; ++i)
+  {
+    f32 x = (f32)(rng_pcg32_next(&rng) >> 20) * 0.125f;
+    f32 y = (f32)(rng_pcg32_next(&rng) >> 8) * (1.0f / 16777216.0f) * 160.0f - 80.0f;
+    f32 s = f32_sin(y * 1000.0f);
+    f32 c = f32_cos(y * 1000.0f);
+    f32 fast = f32_rsqrt_fast(x + 1.0f) * f32_sqrt(x + 1.0f);
+    ok &= f32_sqrt(x * x) == x;
+    ok &= f32_log(f32_exp(y)) - y < 1e-5f && y - f32_log(f32_exp(y)) < 1e-5f;
+    ok &= s * s + c * c - 1.0f < 1e-6f && 1.0f - s * s - c * c < 1e-6f;
+    ok &= fast > 0.9982f && fast < 1.0018f;
+  }
+  assert(ok);
+
+  for (i = 0; i < 20; ++i)
+  {
+    values[i] = (f32)i * 0.25f;
+  }
+  f32_exp_n(results, values, 20);
+  ok = 1;
+  for (i = 0; i < 20; ++i)
+  {
+    ok &= results[i] == f32_exp(values[i]);
+  }
+  f32_sqrt_n(results, values, 20);
+  assert(ok && results[16] == 2.0f && results[19] == f32_sqrt(4.75f));
+  f32_log_n(results, values, 20);
+  assert(results[0] == -inf && results[4] == 0.0f && results[19] == f32_log(4.75f));
+  f32_sin_n(results, values, 20);
+  assert(results[0] == 0.0f && results[18] == f32_sin(4.5f));
+  f32_cos_n(results, values, 20);
+  assert(results[0] == 1.0f && results[17] == f32_cos(4.25f));
+  values[3] = 1e10f;
+  f32_sin_n(results, values, 20);
+  assert(results[3] == f32_sin(1e10f) && results[2] == f32_sin(0.5f) && results[19] == f32_sin(4.75f));
+  f32_cos_n(results, values, 20);
+  assert(results[3] == f32_cos(1e10f) && results[2] == f32_cos(0.5f));
+  f32_rsqrt_n(results, values, 20);
+  assert(results[4] == 1.0f && results[16] == 0.5f);
+  f32_rsqrt_fast_n(results, values + 1, 19);
+  assert(results[15] > 0.499f && results[15] < 0.501f);
+}
 
 int main(void)
 {
@@ -122,8 +1538,33 @@ int main(void)
   types_test_constants();
   types_test_booleans();
   types_test_bit_macros();
+#ifndef TYPES_NATIVE64
   types_test_u64();
   types_test_i64();
+#endif
+  types_test_u64_api();
+  types_test_u64_to();
+  types_test_u64_divmod();
+  types_test_u64_mixed();
+  types_test_u128();
+  types_test_divider();
+  types_test_i64_divmod();
+  types_test_u64_n();
+  types_test_sums();
+  types_test_bits();
+  types_test_bitset();
+  types_test_overflow();
+  types_test_fixed_point();
+  types_test_hash();
+  types_test_rng();
+  types_test_arena();
+  types_test_memory();
+  types_test_endian();
+  types_test_varint();
+  types_test_format();
+  types_test_parse();
+  types_test_float();
+  types_test_math();
 
   return 0;
 }
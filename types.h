@@ -28,6 +28,35 @@ LICENSE
 
 #define TYPES_API static
 
+/* __builtin_add/sub/mul_overflow (GCC 5+, Clang) */
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_add_overflow)
+#define TYPES_HAS_BUILTIN_OVERFLOW
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 5
+#define TYPES_HAS_BUILTIN_OVERFLOW
+#endif
+
+/* Pointer does not alias other pointers (C99 restrict) */
+#if __STDC_VERSION__ >= 199901L
+#define TYPES_RESTRICT restrict
+#elif defined(__GNUC__) || defined(__clang__)
+#define TYPES_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define TYPES_RESTRICT __restrict
+#else
+#define TYPES_RESTRICT
+#endif
+
+/* Define TYPES_BRANCHLESS to compute the emulated 64-bit shifts and
+ * comparisons with masks instead of data dependent branches. This avoids
+ * mispredictions on random inputs and makes them run in constant time.
+ */
+#ifdef TYPES_BRANCHLESS
+/* 1 if the u32 x is non-zero, 0 otherwise */
+#define TYPES_CT_NONZERO(x) (((x) | (0U - (x))) >> 31)
+#endif
+
 typedef unsigned char u8;
 typedef unsigned short u16;
 typedef unsigned int u32;
@@ -60,7 +89,12 @@ typedef int b32;
 #define I32_MIN (-I32_MAX - 1)
 #define BIT(n) (1U << (n))
 #define BIT_SET(x, n) ((x) |= BIT(n))
-#define BIT_CLEAR(x, n) ((x) &= (u8)~BIT(n))
+/* ~BIT(n) in the widest native word (TYPES_BIT_WORD), limited to the width
+ * of x. It keeps the upper bits of a 64-bit x and converts back to a narrow
+ * x without a -Wconversion warning. sizeof does not evaluate x.
+ */
+#define TYPES_BIT_MASK(x) (sizeof(x) >= sizeof(TYPES_BIT_WORD) ? ~(TYPES_BIT_WORD)0 : ((TYPES_BIT_WORD)1 << (8 * sizeof(x))) - 1U)
+#define BIT_CLEAR(x, n) ((x) &= ~(TYPES_BIT_WORD)BIT(n) & TYPES_BIT_MASK(x))
 #define BIT_TOGGLE(x, n) ((x) ^= BIT(n))
 #define BIT_CHECK(x, n) (((x) & BIT(n)) != 0)
 
@@ -77,561 +111,7007 @@ TYPES_STATIC_ASSERT(sizeof(f64) == 8, f64_size_must_be_8);
 TYPES_STATIC_ASSERT(sizeof(b8) == 1, b8_size_must_be_1);
 TYPES_STATIC_ASSERT(sizeof(b32) == 4, b32_size_must_be_4);
 
-/* If the user of this api uses C standard >= C99/ANSI we use long long type directly */
-#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
-typedef unsigned long long u64;
-typedef long long i64;
+/* #############################################################################
+ * # 32-bit Bit Operations
+ * #############################################################################
+ *
+ * Map onto compiler builtins or intrinsics where available and fall back to
+ * portable SWAR and de Bruijn code otherwise. clz and ctz return 32 for zero.
+ * Rotations use the shift pattern that compilers turn into a rotate
+ * instruction. The count is taken modulo 32.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#pragma intrinsic(_BitScanReverse)
+#pragma intrinsic(_BitScanForward)
+#pragma intrinsic(_byteswap_ulong)
+#endif
+
+/* Number of set bits */
+TYPES_API TYPES_INLINE int u32_popcount(u32 x)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__POPCNT__)
+  return __builtin_popcount(x);
+#else
+  /* Without a popcnt instruction the builtins may call into libgcc */
+  x = x - ((x >> 1) & 0x55555555);
+  x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+  x = (x + (x >> 4)) & 0x0F0F0F0F;
+  return (int)((x * 0x01010101) >> 24);
+#endif
+}
+
+/* Number of leading zero bits */
+TYPES_API TYPES_INLINE int u32_clz(u32 x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return x ? __builtin_clz(x) : 32;
+#elif defined(_MSC_VER)
+  unsigned long index;
+  return _BitScanReverse(&index, x) ? 31 - (int)index : 32;
+#else
+  int n = 0;
+  if (x == 0)
+  {
+    return 32;
+  }
+  if ((x & 0xFFFF0000) == 0)
+  {
+    n += 16;
+    x <<= 16;
+  }
+  if ((x & 0xFF000000) == 0)
+  {
+    n += 8;
+    x <<= 8;
+  }
+  if ((x & 0xF0000000) == 0)
+  {
+    n += 4;
+    x <<= 4;
+  }
+  if ((x & 0xC0000000) == 0)
+  {
+    n += 2;
+    x <<= 2;
+  }
+  if ((x & 0x80000000) == 0)
+  {
+    n += 1;
+  }
+  return n;
+#endif
+}
+
+/* Number of trailing zero bits */
+TYPES_API TYPES_INLINE int u32_ctz(u32 x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return x ? __builtin_ctz(x) : 32;
+#elif defined(_MSC_VER)
+  unsigned long index;
+  return _BitScanForward(&index, x) ? (int)index : 32;
+#else
+  /* Isolate the lowest set bit and look its index up by a de Bruijn sequence */
+  static const u8 table[32] = {
+      0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+      31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9};
+  if (x == 0)
+  {
+    return 32;
+  }
+  return table[((x & (0U - x)) * 0x077CB531U) >> 27];
+#endif
+}
+
+/* Reverses the byte order */
+TYPES_API TYPES_INLINE u32 u32_bswap(u32 x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap32(x);
+#elif defined(_MSC_VER)
+  return (u32)_byteswap_ulong(x);
 #else
+  return (x >> 24) | ((x >> 8) & 0x0000FF00) | ((x << 8) & 0x00FF0000) | (x << 24);
+#endif
+}
+
+TYPES_API TYPES_INLINE u32 u32_rotl(u32 x, int n)
+{
+  u32 s = (u32)n & 31;
+  return (x << s) | (x >> ((32 - s) & 31));
+}
+
+TYPES_API TYPES_INLINE u32 u32_rotr(u32 x, int n)
+{
+  u32 s = (u32)n & 31;
+  return (x >> s) | (x << ((32 - s) & 31));
+}
 
 /* #############################################################################
- * # 64-bit Integer Emulation for C89
+ * # 32-bit Helpers
  * #############################################################################
  */
-typedef struct u64
+/* Divides the 64-bit value (u1:u0) by v using only u32 operations.
+ * Requires u1 < v so the quotient fits into 32 bits.
+ * Normalized long division on 16-bit digits (Knuth Algorithm D / Hacker's Delight divlu).
+ */
+TYPES_API TYPES_INLINE u32 types_u32_divlu(u32 u1, u32 u0, u32 v, u32 *remainder)
 {
-  u32 low;
-  u32 high;
-} u64;
+  u32 vn1, vn0, un32, un21, un10, un1, un0, q1, q0, rhat;
+  int s = u32_clz(v);
 
-typedef struct i64
-{
-  u32 low;
-  i32 high;
-} i64;
+  v <<= s;
+  vn1 = v >> 16;
+  vn0 = v & 0xFFFF;
+
+  un32 = s ? ((u1 << s) | (u0 >> (32 - s))) : u1;
+  un10 = u0 << s;
+  un1 = un10 >> 16;
+  un0 = un10 & 0xFFFF;
+
+  q1 = un32 / vn1;
+  rhat = un32 - q1 * vn1;
+  while (q1 > 0xFFFF || q1 * vn0 > ((rhat << 16) | un1))
+  {
+    q1 -= 1;
+    rhat += vn1;
+    if (rhat > 0xFFFF)
+    {
+      break;
+    }
+  }
+
+  un21 = (un32 << 16) + un1 - q1 * v;
+
+  q0 = un21 / vn1;
+  rhat = un21 - q0 * vn1;
+  while (q0 > 0xFFFF || q0 * vn0 > ((rhat << 16) | un0))
+  {
+    q0 -= 1;
+    rhat += vn1;
+    if (rhat > 0xFFFF)
+    {
+      break;
+    }
+  }
+
+  *remainder = ((un21 << 16) + un0 - q0 * v) >> s;
+  return (q1 << 16) | q0;
+}
+
+/* Native 64-bit integers are used for C99 and later. Under C89 define
+ * TYPES_FORCE_NATIVE64 to use the compilers long long / __int64 extension
+ * instead of the struct emulation. Both provide the same function API.
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define TYPES_NATIVE64
+typedef unsigned long long u64;
+typedef long long i64;
+#elif defined(TYPES_FORCE_NATIVE64) && (defined(__GNUC__) || defined(__clang__))
+#define TYPES_NATIVE64
+__extension__ typedef unsigned long long u64;
+__extension__ typedef long long i64;
+#elif defined(TYPES_FORCE_NATIVE64) && defined(_MSC_VER)
+#define TYPES_NATIVE64
+typedef unsigned __int64 u64;
+typedef __int64 i64;
+#endif
+
+/* Widest native unsigned integer, BIT_CLEAR builds its mask in it */
+#ifdef TYPES_NATIVE64
+#define TYPES_BIT_WORD u64
+#else
+#define TYPES_BIT_WORD unsigned long
+#endif
+
+#ifdef TYPES_NATIVE64
 
 TYPES_STATIC_ASSERT(sizeof(u64) == 8, u64_size_must_be_8);
 TYPES_STATIC_ASSERT(sizeof(i64) == 8, i64_size_must_be_8);
 
 /* #############################################################################
- * # 64-bit Integer Operations
+ * # 64-bit Integer Operations (native)
  * #############################################################################
+ *
+ * Thin wrappers over the built-in operators. Signed add/sub/mul/neg go
+ * through the unsigned type so they wrap like the emulation instead of
+ * overflowing.
  */
 
 /* ---- Bitwise Operators (Unsigned) ---- */
 TYPES_API TYPES_INLINE u64 u64_and(u64 a, u64 b)
 {
-  u64 r;
-  r.high = a.high & b.high;
-  r.low = a.low & b.low;
-  return r;
+  return a & b;
 }
 
 TYPES_API TYPES_INLINE u64 u64_or(u64 a, u64 b)
 {
-  u64 r;
-  r.high = a.high | b.high;
-  r.low = a.low | b.low;
-  return r;
+  return a | b;
 }
 
 TYPES_API TYPES_INLINE u64 u64_xor(u64 a, u64 b)
 {
-  u64 r;
-  r.high = a.high ^ b.high;
-  r.low = a.low ^ b.low;
-  return r;
+  return a ^ b;
 }
 
 TYPES_API TYPES_INLINE u64 u64_not(u64 a)
 {
-  u64 r;
-  r.high = ~a.high;
-  r.low = ~a.low;
-  return r;
+  return ~a;
 }
 
 /* ---- Bitwise Operators (Signed) ---- */
 TYPES_API TYPES_INLINE i64 i64_and(i64 a, i64 b)
 {
-  i64 r;
-  r.high = a.high & b.high;
-  r.low = a.low & b.low;
-  return r;
+  return a & b;
 }
 
 TYPES_API TYPES_INLINE i64 i64_or(i64 a, i64 b)
 {
-  i64 r;
-  r.high = a.high | b.high;
-  r.low = a.low | b.low;
-  return r;
+  return a | b;
 }
 
 TYPES_API TYPES_INLINE i64 i64_xor(i64 a, i64 b)
 {
-  i64 r;
-  r.high = a.high ^ b.high;
-  r.low = a.low ^ b.low;
-  return r;
+  return a ^ b;
 }
 
 TYPES_API TYPES_INLINE i64 i64_not(i64 a)
 {
-  i64 r;
-  r.high = ~a.high;
-  r.low = ~a.low;
-  return r;
+  return ~a;
 }
 
 /* ---- Unsigned Math ---- */
 TYPES_API TYPES_INLINE u64 u64_add(u64 a, u64 b)
 {
-  u64 res;
-  res.low = a.low + b.low;
-  res.high = a.high + b.high + (res.low < a.low);
-  return res;
+  return a + b;
 }
 
 TYPES_API TYPES_INLINE u64 u64_sub(u64 a, u64 b)
 {
-  u64 res;
-  res.low = a.low - b.low;
-  res.high = a.high - b.high - (a.low < b.low);
-  return res;
+  return a - b;
 }
 
 TYPES_API TYPES_INLINE u64 u64_shl(u64 a, int n)
 {
-  u64 res = {0, 0};
-  if (n >= 64)
-  {
-    res.high = 0;
-    res.low = 0;
-  }
-  else if (n >= 32)
-  {
-    res.high = a.low << (n - 32);
-    res.low = 0;
-  }
-  else if (n > 0)
-  {
-    res.high = (a.high << n) | (a.low >> (32 - n));
-    res.low = a.low << n;
-  }
-  else
-  {
-    res = a;
-  }
-  return res;
+#ifdef TYPES_BRANCHLESS
+  u64 keep = (u64)0 - (((u32)n >> 31) | (((u32)n - 1U) >> 31));
+  u64 zero = (u64)0 - TYPES_CT_NONZERO((u32)n >> 6);
+  return ((a << (n & 63)) & ~zero & ~keep) | (a & keep);
+#else
+  return (n >= 64) ? 0 : (n > 0) ? a << n : a;
+#endif
 }
 
 TYPES_API TYPES_INLINE u64 u64_shr(u64 a, int n)
 {
-  u64 res = {0, 0};
-  if (n >= 64)
-  {
-    res.high = 0;
-    res.low = 0;
-  }
-  else if (n >= 32)
-  {
-    res.low = a.high >> (n - 32);
-    res.high = 0;
-  }
-  else if (n > 0)
-  {
-    res.low = (a.low >> n) | (a.high << (32 - n));
-    res.high = a.high >> n;
-  }
-  else
-  {
-    res = a;
-  }
-  return res;
+#ifdef TYPES_BRANCHLESS
+  u64 keep = (u64)0 - (((u32)n >> 31) | (((u32)n - 1U) >> 31));
+  u64 zero = (u64)0 - TYPES_CT_NONZERO((u32)n >> 6);
+  return ((a >> (n & 63)) & ~zero & ~keep) | (a & keep);
+#else
+  return (n >= 64) ? 0 : (n > 0) ? a >> n : a;
+#endif
 }
 
-TYPES_API TYPES_INLINE u64 u64_mul(u64 a, u64 b)
+TYPES_API TYPES_INLINE u32 types_u32_mul_wide(u32 a, u32 b, u32 *high)
 {
-  u64 res;
-  u32 a_low = a.low, a_high = a.high;
-  u32 b_low = b.low, b_high = b.high;
-
-  u32 low_low = (a_low & 0xFFFF) * (b_low & 0xFFFF);
-  u32 low_high = (a_low >> 16) * (b_low & 0xFFFF);
-  u32 high_low = (a_low & 0xFFFF) * (b_low >> 16);
-  u32 high_high = (a_low >> 16) * (b_low >> 16);
-
-  u32 mid = low_high + high_low;
-  u32 mid_loww = (mid & 0xFFFF) << 16;
-  u32 mid_highgh = (mid >> 16);
-
-  u32 carry;
-
-  res.low = low_low + mid_loww;
-  carry = (res.low < low_low);
+  u64 r = (u64)a * (u64)b;
+  *high = (u32)(r >> 32);
+  return (u32)r;
+}
 
-  res.high = a_high * b_low + a_low * b_high + high_high + mid_highgh + carry;
+TYPES_API TYPES_INLINE u64 u64_mul(u64 a, u64 b)
+{
+  return a * b;
+}
 
-  return res;
+/* The divisor must not be zero. */
+TYPES_API TYPES_INLINE u64 u64_divmod(u64 dividend, u64 divisor, u64 *remainder)
+{
+  *remainder = dividend % divisor;
+  return dividend / divisor;
 }
 
 TYPES_API TYPES_INLINE u64 u64_div(u64 dividend, u64 divisor)
 {
-  u64 quotient = {0, 0};
-  u64 remainder = {0, 0};
-  int i;
-
-  for (i = 63; i >= 0; --i)
-  {
-    remainder = u64_shl(remainder, 1);
-    if ((dividend.high >> 31) & 1)
-    {
-      remainder.low |= 1;
-    }
-    dividend = u64_shl(dividend, 1);
+  return dividend / divisor;
+}
 
-    if ((remainder.high > divisor.high) ||
-        (remainder.high == divisor.high && remainder.low >= divisor.low))
-    {
-      remainder = u64_sub(remainder, divisor);
-      quotient.low |= 1;
-    }
+TYPES_API TYPES_INLINE u64 u64_mod(u64 dividend, u64 divisor)
+{
+  return dividend % divisor;
+}
 
-    quotient = u64_shl(quotient, 1);
-  }
+/* ---- Unsigned Math (u64 with u32 operand) ---- */
+TYPES_API TYPES_INLINE u64 u64_add_u32(u64 a, u32 b)
+{
+  return a + b;
+}
 
-  quotient = u64_shr(quotient, 1);
-  return quotient;
+TYPES_API TYPES_INLINE u64 u64_sub_u32(u64 a, u32 b)
+{
+  return a - b;
 }
 
-TYPES_API TYPES_INLINE u64 u64_mod(u64 dividend, u64 divisor)
+TYPES_API TYPES_INLINE u64 u64_mul_u32(u64 a, u32 b)
 {
-  u64 remainder = {0, 0};
-  int i;
+  return a * b;
+}
 
-  for (i = 63; i >= 0; --i)
-  {
-    remainder = u64_shl(remainder, 1);
-    if ((dividend.high >> 31) & 1)
-    {
-      remainder.low |= 1;
-    }
-    dividend = u64_shl(dividend, 1);
+TYPES_API TYPES_INLINE u64 u64_divmod_u32(u64 dividend, u32 divisor, u32 *remainder)
+{
+  *remainder = (u32)(dividend % divisor);
+  return dividend / divisor;
+}
 
-    if ((remainder.high > divisor.high) ||
-        (remainder.high == divisor.high && remainder.low >= divisor.low))
-    {
-      remainder = u64_sub(remainder, divisor);
-    }
-  }
+TYPES_API TYPES_INLINE u64 u64_div_u32(u64 dividend, u32 divisor)
+{
+  return dividend / divisor;
+}
 
-  return remainder;
+TYPES_API TYPES_INLINE u32 u64_mod_u32(u64 dividend, u32 divisor)
+{
+  return (u32)(dividend % divisor);
 }
 
 /* ---- Signed Math ---- */
 TYPES_API TYPES_INLINE i64 i64_add(i64 a, i64 b)
 {
-  i64 res;
-  u64 ua;
-  u64 ub;
-  u64 ur;
-
-  ua.low = a.low;
-  ua.high = (u32)a.high;
-
-  ub.low = b.low;
-  ub.high = (u32)b.high;
-
-  ur = u64_add(ua, ub);
-
-  res.high = (i32)ur.high;
-  res.low = ur.low;
-  return res;
+  return (i64)((u64)a + (u64)b);
 }
 
 TYPES_API TYPES_INLINE i64 i64_sub(i64 a, i64 b)
 {
-  i64 res;
-  u64 ua;
-  u64 ub;
-  u64 ur;
-
-  ua.low = a.low;
-  ua.high = (u32)a.high;
-
-  ub.low = b.low;
-  ub.high = (u32)b.high;
-
-  ur = u64_sub(ua, ub);
-
-  res.high = (i32)ur.high;
-  res.low = ur.low;
-
-  return res;
+  return (i64)((u64)a - (u64)b);
 }
 
 TYPES_API TYPES_INLINE i64 i64_shl(i64 a, int n)
 {
-  u64 ua;
-  u64 ur;
-  i64 res;
-
-  ua.low = a.low;
-  ua.high = (u32)a.high;
-
-  ur = u64_shl(ua, n);
+  return (i64)u64_shl((u64)a, n);
+}
 
-  res.low = ur.low;
-  res.high = (i32)ur.high;
+TYPES_API TYPES_INLINE i64 i64_shr(i64 a, int n)
+{
+#ifdef TYPES_BRANCHLESS
+  u64 ua = (u64)a;
+  u64 sign = (u64)0 - (ua >> 63);
+  u64 keep = (u64)0 - (((u32)n >> 31) | (((u32)n - 1U) >> 31));
+  u64 fill = (u64)0 - TYPES_CT_NONZERO((u32)n >> 6);
+  int s = n & 63;
+  u64 r = (ua >> s) | ((sign << 1) << (63 - s));
+  r = (r & ~fill) | (sign & fill);
+  return (i64)((r & ~keep) | (ua & keep));
+#else
+  return (n >= 64) ? ((a < 0) ? -1 : 0) : (n > 0) ? a >> n : a;
+#endif
+}
+
+TYPES_API TYPES_INLINE i64 i64_neg(i64 a)
+{
+  return (i64)(0 - (u64)a);
+}
+
+TYPES_API TYPES_INLINE i64 i64_mul(i64 a, i64 b)
+{
+  return (i64)((u64)a * (u64)b);
+}
+
+/* Truncating division, the remainder has the sign of the dividend. The divisor must not be zero.
+ * A divisor of -1 negates like the emulation, so I64_MIN / -1 wraps to I64_MIN
+ * with remainder 0 instead of overflowing (a trap on x86).
+ */
+TYPES_API TYPES_INLINE i64 i64_divmod(i64 a, i64 b, i64 *remainder)
+{
+  if (b == -1)
+  {
+    *remainder = 0;
+    return i64_neg(a);
+  }
+  *remainder = a % b;
+  return a / b;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div(i64 a, i64 b)
+{
+  return (b == -1) ? i64_neg(a) : a / b;
+}
+
+TYPES_API TYPES_INLINE i64 i64_mod(i64 a, i64 b)
+{
+  return (b == -1) ? 0 : a % b;
+}
+
+/* Floored division: the quotient rounds towards negative infinity and the
+ * remainder has the sign of the divisor.
+ */
+TYPES_API TYPES_INLINE i64 i64_divmod_floor(i64 a, i64 b, i64 *remainder)
+{
+  i64 r;
+  i64 q = i64_divmod(a, b, &r);
+
+  if (r != 0 && (r < 0) != (b < 0))
+  {
+    q -= 1;
+    r += b;
+  }
+  *remainder = r;
+  return q;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div_floor(i64 a, i64 b)
+{
+  i64 remainder;
+  return i64_divmod_floor(a, b, &remainder);
+}
+
+TYPES_API TYPES_INLINE i64 i64_mod_floor(i64 a, i64 b)
+{
+  i64 remainder;
+  i64_divmod_floor(a, b, &remainder);
+  return remainder;
+}
+
+/* Euclidean division: the remainder is always in [0, |b|). */
+TYPES_API TYPES_INLINE i64 i64_divmod_euclid(i64 a, i64 b, i64 *remainder)
+{
+  i64 r;
+  i64 q = i64_divmod(a, b, &r);
+
+  if (r < 0)
+  {
+    q = (b < 0) ? q + 1 : q - 1;
+    r = (b < 0) ? r - b : r + b;
+  }
+  *remainder = r;
+  return q;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div_euclid(i64 a, i64 b)
+{
+  i64 remainder;
+  return i64_divmod_euclid(a, b, &remainder);
+}
+
+TYPES_API TYPES_INLINE i64 i64_mod_euclid(i64 a, i64 b)
+{
+  i64 remainder;
+  i64_divmod_euclid(a, b, &remainder);
+  return remainder;
+}
+
+/* ---- Signed Math (i64 with i32 operand) ---- */
+TYPES_API TYPES_INLINE i64 i64_add_i32(i64 a, i32 b)
+{
+  return (i64)((u64)a + (u64)(i64)b);
+}
+
+TYPES_API TYPES_INLINE i64 i64_sub_i32(i64 a, i32 b)
+{
+  return (i64)((u64)a - (u64)(i64)b);
+}
+
+TYPES_API TYPES_INLINE i64 i64_mul_i32(i64 a, i32 b)
+{
+  return (i64)((u64)a * (u64)(i64)b);
+}
+
+/* I64_MIN / -1 wraps like i64_divmod */
+TYPES_API TYPES_INLINE i64 i64_divmod_i32(i64 dividend, i32 divisor, i32 *remainder)
+{
+  if (divisor == -1)
+  {
+    *remainder = 0;
+    return i64_neg(dividend);
+  }
+  *remainder = (i32)(dividend % divisor);
+  return dividend / divisor;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div_i32(i64 dividend, i32 divisor)
+{
+  return (divisor == -1) ? i64_neg(dividend) : dividend / divisor;
+}
+
+TYPES_API TYPES_INLINE i32 i64_mod_i32(i64 dividend, i32 divisor)
+{
+  return (divisor == -1) ? 0 : (i32)(dividend % divisor);
+}
+
+/* ---- Unsigned Comparisons ---- */
+TYPES_API TYPES_INLINE int u64_eq(u64 a, u64 b)
+{
+#ifdef TYPES_BRANCHLESS
+  u64 x = a ^ b;
+  return (int)(1U ^ (u32)((x | ((u64)0 - x)) >> 63));
+#else
+  return a == b;
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_ne(u64 a, u64 b)
+{
+  return a != b;
+}
+
+TYPES_API TYPES_INLINE int u64_lt(u64 a, u64 b)
+{
+#ifdef TYPES_BRANCHLESS
+  /* Borrow out of a - b */
+  return (int)(((~a & b) | (~(a ^ b) & (a - b))) >> 63);
+#else
+  return a < b;
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_le(u64 a, u64 b)
+{
+#ifdef TYPES_BRANCHLESS
+  return (int)(1U ^ (u32)u64_lt(b, a));
+#else
+  return a <= b;
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_gt(u64 a, u64 b)
+{
+  return a > b;
+}
+
+TYPES_API TYPES_INLINE int u64_ge(u64 a, u64 b)
+{
+  return a >= b;
+}
+
+/* ---- Signed Comparisons ---- */
+TYPES_API TYPES_INLINE int i64_eq(i64 a, i64 b)
+{
+#ifdef TYPES_BRANCHLESS
+  return u64_eq((u64)a, (u64)b);
+#else
+  return a == b;
+#endif
+}
+
+TYPES_API TYPES_INLINE int i64_ne(i64 a, i64 b)
+{
+  return a != b;
+}
+
+TYPES_API TYPES_INLINE int i64_lt(i64 a, i64 b)
+{
+#ifdef TYPES_BRANCHLESS
+  u64 sign = (u64)1 << 63;
+  return u64_lt((u64)a ^ sign, (u64)b ^ sign);
+#else
+  return a < b;
+#endif
+}
+
+TYPES_API TYPES_INLINE int i64_le(i64 a, i64 b)
+{
+#ifdef TYPES_BRANCHLESS
+  return (int)(1U ^ (u32)i64_lt(b, a));
+#else
+  return a <= b;
+#endif
+}
+
+TYPES_API TYPES_INLINE int i64_gt(i64 a, i64 b)
+{
+  return a > b;
+}
+
+TYPES_API TYPES_INLINE int i64_ge(i64 a, i64 b)
+{
+  return a >= b;
+}
+
+/* Conversion functions */
+TYPES_API TYPES_INLINE u64 u64_from_u32(u32 x)
+{
+  return (u64)x;
+}
+
+TYPES_API TYPES_INLINE i64 i64_from_i32(i32 x)
+{
+  return (i64)x;
+}
+
+TYPES_API TYPES_INLINE double double_from_u64(u64 x)
+{
+  return (double)x;
+}
+
+TYPES_API TYPES_INLINE double double_from_i64(i64 x)
+{
+  return (double)x;
+}
+
+/* Construction and access of the two 32-bit words */
+TYPES_API TYPES_INLINE u64 u64_make(u32 high, u32 low)
+{
+  return ((u64)high << 32) | (u64)low;
+}
+
+TYPES_API TYPES_INLINE u32 u64_high(u64 x)
+{
+  return (u32)(x >> 32);
+}
+
+TYPES_API TYPES_INLINE u32 u64_low(u64 x)
+{
+  return (u32)x;
+}
+
+TYPES_API TYPES_INLINE i64 i64_make(i32 high, u32 low)
+{
+  return (i64)(((u64)(u32)high << 32) | (u64)low);
+}
+
+TYPES_API TYPES_INLINE i32 i64_high(i64 x)
+{
+  return (i32)(x >> 32);
+}
+
+TYPES_API TYPES_INLINE u32 i64_low(i64 x)
+{
+  return (u32)x;
+}
+
+/* Reinterpret the two's complement bit pattern */
+TYPES_API TYPES_INLINE u64 u64_from_i64(i64 x)
+{
+  return (u64)x;
+}
+
+TYPES_API TYPES_INLINE i64 i64_from_u64(u64 x)
+{
+  return (i64)x;
+}
+
+#else
+
+/* #############################################################################
+ * # 64-bit Integer Emulation for C89
+ * #############################################################################
+ */
+typedef struct u64
+{
+  u32 low;
+  u32 high;
+} u64;
+
+typedef struct i64
+{
+  u32 low;
+  i32 high;
+} i64;
+
+TYPES_STATIC_ASSERT(sizeof(u64) == 8, u64_size_must_be_8);
+TYPES_STATIC_ASSERT(sizeof(i64) == 8, i64_size_must_be_8);
+
+/* #############################################################################
+ * # 64-bit Integer Operations
+ * #############################################################################
+ */
+
+/* Define TYPES_SIMD to implement the logic ops, add, sub, shifts and compares
+ * of the emulated u64 with SSE2 or NEON 64-bit lanes. The struct layout and
+ * the function signatures stay the same. Detection uses the compilers
+ * predefined macros, other targets keep the scalar code.
+ */
+#if defined(TYPES_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TYPES_SIMD_SSE2
+#include <emmintrin.h>
+
+/* Loads the 8 byte struct into the low lane */
+#define TYPES_SSE2_LOAD(x) _mm_loadl_epi64((const __m128i *)(const void *)&(x))
+#define TYPES_SIMD_COMPARE
+
+#elif defined(TYPES_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__ARM_BIG_ENDIAN)
+#define TYPES_SIMD_NEON
+#include <arm_neon.h>
+
+/* 64-bit lane compares are AArch64 only */
+#if defined(__aarch64__)
+#define TYPES_SIMD_COMPARE
+#endif
+
+TYPES_API TYPES_INLINE uint64x1_t types_neon_load(u64 x)
+{
+  return vreinterpret_u64_u32(vset_lane_u32(x.high, vdup_n_u32(x.low), 1));
+}
+
+TYPES_API TYPES_INLINE u64 types_neon_store(uint64x1_t v)
+{
+  u64 r;
+  uint32x2_t w = vreinterpret_u32_u64(v);
+  r.low = vget_lane_u32(w, 0);
+  r.high = vget_lane_u32(w, 1);
+  return r;
+}
+
+/* USHL/SSHL only read the low byte of the count as a signed value, so a
+ * count of 128 or more would wrap. Negative counts become 0, counts above
+ * 64 become 64, which shifts out every bit.
+ */
+TYPES_API TYPES_INLINE i32 types_neon_shift_count(int n)
+{
+  u32 count = (u32)n & ~(0U - ((u32)n >> 31));
+  return (i32)(count > 64 ? 64 : count);
+}
+#endif
+
+/* ---- Bitwise Operators (Unsigned) ---- */
+TYPES_API TYPES_INLINE u64 u64_and(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_SSE2)
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_and_si128(TYPES_SSE2_LOAD(a), TYPES_SSE2_LOAD(b)));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  return types_neon_store(vand_u64(types_neon_load(a), types_neon_load(b)));
+#else
+  u64 r;
+  r.high = a.high & b.high;
+  r.low = a.low & b.low;
+  return r;
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_or(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_SSE2)
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_or_si128(TYPES_SSE2_LOAD(a), TYPES_SSE2_LOAD(b)));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  return types_neon_store(vorr_u64(types_neon_load(a), types_neon_load(b)));
+#else
+  u64 r;
+  r.high = a.high | b.high;
+  r.low = a.low | b.low;
+  return r;
+#endif
+}
 
+TYPES_API TYPES_INLINE u64 u64_xor(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_SSE2)
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_xor_si128(TYPES_SSE2_LOAD(a), TYPES_SSE2_LOAD(b)));
   return res;
+#elif defined(TYPES_SIMD_NEON)
+  return types_neon_store(veor_u64(types_neon_load(a), types_neon_load(b)));
+#else
+  u64 r;
+  r.high = a.high ^ b.high;
+  r.low = a.low ^ b.low;
+  return r;
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_not(u64 a)
+{
+#if defined(TYPES_SIMD_SSE2)
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_xor_si128(TYPES_SSE2_LOAD(a), _mm_set1_epi32(-1)));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  return types_neon_store(vreinterpret_u64_u32(vmvn_u32(vreinterpret_u32_u64(types_neon_load(a)))));
+#else
+  u64 r;
+  r.high = ~a.high;
+  r.low = ~a.low;
+  return r;
+#endif
+}
+
+/* ---- Bitwise Operators (Signed) ---- */
+TYPES_API TYPES_INLINE i64 i64_and(i64 a, i64 b)
+{
+  i64 r;
+  r.high = a.high & b.high;
+  r.low = a.low & b.low;
+  return r;
+}
+
+TYPES_API TYPES_INLINE i64 i64_or(i64 a, i64 b)
+{
+  i64 r;
+  r.high = a.high | b.high;
+  r.low = a.low | b.low;
+  return r;
+}
+
+TYPES_API TYPES_INLINE i64 i64_xor(i64 a, i64 b)
+{
+  i64 r;
+  r.high = a.high ^ b.high;
+  r.low = a.low ^ b.low;
+  return r;
+}
+
+TYPES_API TYPES_INLINE i64 i64_not(i64 a)
+{
+  i64 r;
+  r.high = ~a.high;
+  r.low = ~a.low;
+  return r;
+}
+
+/* ---- Unsigned Math ---- */
+TYPES_API TYPES_INLINE u64 u64_add(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_SSE2)
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_add_epi64(TYPES_SSE2_LOAD(a), TYPES_SSE2_LOAD(b)));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  return types_neon_store(vadd_u64(types_neon_load(a), types_neon_load(b)));
+#else
+  u64 res;
+  res.low = a.low + b.low;
+  res.high = a.high + b.high + (res.low < a.low);
+  return res;
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_sub(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_SSE2)
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_sub_epi64(TYPES_SSE2_LOAD(a), TYPES_SSE2_LOAD(b)));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  return types_neon_store(vsub_u64(types_neon_load(a), types_neon_load(b)));
+#else
+  u64 res;
+  res.low = a.low - b.low;
+  res.high = a.high - b.high - (a.low < b.low);
+  return res;
+#endif
+}
+
+/* Shifts on the words high:low, shared with the pointer variants. Return the
+ * low word of the result. Counts >= 64 yield 0, counts <= 0 leave the value.
+ */
+TYPES_API TYPES_INLINE u32 types_u64_shl_words(u32 high, u32 low, int n, u32 *r_high)
+{
+#ifdef TYPES_BRANCHLESS
+  /* Move the low word up first for n >= 32, then shift both words by n % 32 */
+  u32 un = (u32)n;
+  u32 s = un & 31;
+  u32 keep = 0U - ((un >> 31) | ((un - 1U) >> 31));
+  u32 valid = ~keep & (TYPES_CT_NONZERO(un >> 6) - 1U);
+  u32 word = 0U - ((un >> 5) & 1);
+  u32 lo = low & ~word;
+  u32 hi = (high & ~word) | (low & word);
+  *r_high = (((hi << s) | ((lo >> 1) >> (31 - s))) & valid) | (high & keep);
+  return ((lo << s) & valid) | (low & keep);
+#else
+  if (n >= 64)
+  {
+    *r_high = 0;
+    return 0;
+  }
+  else if (n >= 32)
+  {
+    *r_high = low << (n - 32);
+    return 0;
+  }
+  else if (n > 0)
+  {
+    *r_high = (high << n) | (low >> (32 - n));
+    return low << n;
+  }
+  *r_high = high;
+  return low;
+#endif
+}
+
+TYPES_API TYPES_INLINE u32 types_u64_shr_words(u32 high, u32 low, int n, u32 *r_high)
+{
+#ifdef TYPES_BRANCHLESS
+  /* Move the high word down first for n >= 32, then shift both words by n % 32 */
+  u32 un = (u32)n;
+  u32 s = un & 31;
+  u32 keep = 0U - ((un >> 31) | ((un - 1U) >> 31));
+  u32 valid = ~keep & (TYPES_CT_NONZERO(un >> 6) - 1U);
+  u32 word = 0U - ((un >> 5) & 1);
+  u32 hi = high & ~word;
+  u32 lo = (low & ~word) | (high & word);
+  *r_high = ((hi >> s) & valid) | (high & keep);
+  return (((lo >> s) | ((hi << 1) << (31 - s))) & valid) | (low & keep);
+#else
+  if (n >= 64)
+  {
+    *r_high = 0;
+    return 0;
+  }
+  else if (n >= 32)
+  {
+    *r_high = 0;
+    return high >> (n - 32);
+  }
+  else if (n > 0)
+  {
+    *r_high = high >> n;
+    return (low >> n) | (high << (32 - n));
+  }
+  *r_high = high;
+  return low;
+#endif
+}
+
+/* Arithmetic shift, high holds the bits of the signed high word */
+TYPES_API TYPES_INLINE u32 types_i64_shr_words(u32 high, u32 low, int n, u32 *r_high)
+{
+#ifdef TYPES_BRANCHLESS
+  /* Like types_u64_shr_words but the vacated bits are filled with the sign */
+  u32 un = (u32)n;
+  u32 s = un & 31;
+  u32 sign = 0U - (high >> 31);
+  u32 keep = 0U - ((un >> 31) | ((un - 1U) >> 31));
+  u32 fill = 0U - TYPES_CT_NONZERO(un >> 6);
+  u32 word = 0U - ((un >> 5) & 1);
+  u32 hi = (high & ~word) | (sign & word);
+  u32 lo = (low & ~word) | (high & word);
+  u32 r_low = (lo >> s) | ((hi << 1) << (31 - s));
+  u32 r_hi = (hi >> s) | ((sign << 1) << (31 - s));
+  *r_high = (((r_hi & ~fill) | (sign & fill)) & ~keep) | (high & keep);
+  return (((r_low & ~fill) | (sign & fill)) & ~keep) | (low & keep);
+#else
+  u32 sign = 0U - (high >> 31);
+  if (n >= 64)
+  {
+    *r_high = sign;
+    return sign;
+  }
+  else if (n >= 32)
+  {
+    *r_high = sign;
+    return (u32)((i32)high >> (n - 32));
+  }
+  else if (n > 0)
+  {
+    *r_high = (u32)((i32)high >> n);
+    return (low >> n) | (high << (32 - n));
+  }
+  *r_high = high;
+  return low;
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_shl(u64 a, int n)
+{
+#if defined(TYPES_SIMD_SSE2)
+  /* Counts >= 64 yield 0, negative counts are clamped to 0 */
+  u32 count = (u32)n & ~(0U - ((u32)n >> 31));
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_sll_epi64(TYPES_SSE2_LOAD(a), _mm_cvtsi32_si128((int)count)));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  /* USHL yields 0 for counts of 64 */
+  i32 count = types_neon_shift_count(n);
+  return types_neon_store(vshl_u64(types_neon_load(a), vdup_n_s64(count)));
+#else
+  u64 res;
+  res.low = types_u64_shl_words(a.high, a.low, n, &res.high);
+  return res;
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_shr(u64 a, int n)
+{
+#if defined(TYPES_SIMD_SSE2)
+  /* Counts >= 64 yield 0, negative counts are clamped to 0 */
+  u32 count = (u32)n & ~(0U - ((u32)n >> 31));
+  u64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_srl_epi64(TYPES_SSE2_LOAD(a), _mm_cvtsi32_si128((int)count)));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  /* USHL with a negative count shifts right */
+  i32 count = types_neon_shift_count(n);
+  return types_neon_store(vshl_u64(types_neon_load(a), vdup_n_s64(-count)));
+#else
+  u64 res;
+  res.low = types_u64_shr_words(a.high, a.low, n, &res.high);
+  return res;
+#endif
+}
+
+/* Full 32x32->64 bit product using 16-bit partial products. Returns the low word. */
+TYPES_API TYPES_INLINE u32 types_u32_mul_wide(u32 a, u32 b, u32 *high)
+{
+  u32 a_low = a & 0xFFFF, a_high = a >> 16;
+  u32 b_low = b & 0xFFFF, b_high = b >> 16;
+
+  u32 low_low = a_low * b_low;
+  u32 low_high = a_low * b_high;
+  u32 high_low = a_high * b_low;
+  u32 high_high = a_high * b_high;
+
+  /* Cannot overflow: at most 0xFFFF + 0xFFFF + 0xFFFE0001 */
+  u32 mid = (low_low >> 16) + (low_high & 0xFFFF) + high_low;
+
+  *high = high_high + (low_high >> 16) + (mid >> 16);
+  return (mid << 16) | (low_low & 0xFFFF);
+}
+
+TYPES_API TYPES_INLINE u64 u64_mul(u64 a, u64 b)
+{
+  u64 res;
+  res.low = types_u32_mul_wide(a.low, b.low, &res.high);
+  res.high += a.high * b.low + a.low * b.high;
+  return res;
+}
+
+/* Computes quotient and remainder in one pass. The divisor must not be zero. */
+TYPES_API TYPES_INLINE u64 u64_divmod(u64 dividend, u64 divisor, u64 *remainder)
+{
+  u64 quotient;
+  u64 v1;
+  u64 r;
+  u32 q0;
+  int n;
+
+  /* Both operands fit into 32 bits: native u32 division */
+  if (dividend.high == 0 && divisor.high == 0)
+  {
+    quotient.high = 0;
+    quotient.low = dividend.low / divisor.low;
+    remainder->high = 0;
+    remainder->low = dividend.low % divisor.low;
+    return quotient;
+  }
+
+  /* 32-bit divisor: divide the high word, then the remaining 64/32 step */
+  if (divisor.high == 0)
+  {
+    u32 k;
+    quotient.high = dividend.high / divisor.low;
+    k = dividend.high % divisor.low;
+    quotient.low = types_u32_divlu(k, dividend.low, divisor.low, &remainder->low);
+    remainder->high = 0;
+    return quotient;
+  }
+
+  /* Divisor larger than the dividend */
+  if (dividend.high < divisor.high ||
+      (dividend.high == divisor.high && dividend.low < divisor.low))
+  {
+    quotient.high = 0;
+    quotient.low = 0;
+    *remainder = dividend;
+    return quotient;
+  }
+
+  /* General case: the quotient fits into 32 bits. Estimate it from the
+   * normalized top word of the divisor, the estimate is at most one too small.
+   */
+  n = u32_clz(divisor.high);
+  v1 = u64_shl(divisor, n);
+  r = u64_shr(dividend, 1);
+  q0 = types_u32_divlu(r.high, r.low, v1.high, &r.low);
+  q0 >>= 31 - n;
+
+  if (q0 != 0)
+  {
+    q0 -= 1;
+  }
+
+  quotient.high = 0;
+  quotient.low = q0;
+  r = u64_sub(dividend, u64_mul(quotient, divisor));
+
+  if (r.high > divisor.high ||
+      (r.high == divisor.high && r.low >= divisor.low))
+  {
+    q0 += 1;
+    r = u64_sub(r, divisor);
+  }
+
+  quotient.low = q0;
+  *remainder = r;
+  return quotient;
+}
+
+TYPES_API TYPES_INLINE u64 u64_div(u64 dividend, u64 divisor)
+{
+  u64 remainder;
+  return u64_divmod(dividend, divisor, &remainder);
+}
+
+TYPES_API TYPES_INLINE u64 u64_mod(u64 dividend, u64 divisor)
+{
+  u64 remainder;
+  u64_divmod(dividend, divisor, &remainder);
+  return remainder;
+}
+
+/* ---- Unsigned Math (u64 with u32 operand) ---- */
+TYPES_API TYPES_INLINE u64 u64_add_u32(u64 a, u32 b)
+{
+  u64 res;
+  res.low = a.low + b;
+  res.high = a.high + (res.low < b);
+  return res;
+}
+
+TYPES_API TYPES_INLINE u64 u64_sub_u32(u64 a, u32 b)
+{
+  u64 res;
+  res.low = a.low - b;
+  res.high = a.high - (a.low < b);
+  return res;
+}
+
+TYPES_API TYPES_INLINE u64 u64_mul_u32(u64 a, u32 b)
+{
+  u64 res;
+  res.low = types_u32_mul_wide(a.low, b, &res.high);
+  res.high += a.high * b;
+  return res;
+}
+
+/* Computes quotient and remainder of a 64-bit by 32-bit division. The divisor must not be zero. */
+TYPES_API TYPES_INLINE u64 u64_divmod_u32(u64 dividend, u32 divisor, u32 *remainder)
+{
+  u64 quotient;
+
+  if (dividend.high == 0)
+  {
+    quotient.high = 0;
+    quotient.low = dividend.low / divisor;
+    *remainder = dividend.low % divisor;
+    return quotient;
+  }
+
+  quotient.high = dividend.high / divisor;
+  quotient.low = types_u32_divlu(dividend.high % divisor, dividend.low, divisor, remainder);
+  return quotient;
+}
+
+TYPES_API TYPES_INLINE u64 u64_div_u32(u64 dividend, u32 divisor)
+{
+  u32 remainder;
+  return u64_divmod_u32(dividend, divisor, &remainder);
+}
+
+TYPES_API TYPES_INLINE u32 u64_mod_u32(u64 dividend, u32 divisor)
+{
+  u32 remainder;
+  u64_divmod_u32(dividend, divisor, &remainder);
+  return remainder;
+}
+
+/* ---- Signed Math ---- */
+TYPES_API TYPES_INLINE i64 i64_add(i64 a, i64 b)
+{
+  i64 res;
+  u64 ua;
+  u64 ub;
+  u64 ur;
+
+  ua.low = a.low;
+  ua.high = (u32)a.high;
+
+  ub.low = b.low;
+  ub.high = (u32)b.high;
+
+  ur = u64_add(ua, ub);
+
+  res.high = (i32)ur.high;
+  res.low = ur.low;
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_sub(i64 a, i64 b)
+{
+  i64 res;
+  u64 ua;
+  u64 ub;
+  u64 ur;
+
+  ua.low = a.low;
+  ua.high = (u32)a.high;
+
+  ub.low = b.low;
+  ub.high = (u32)b.high;
+
+  ur = u64_sub(ua, ub);
+
+  res.high = (i32)ur.high;
+  res.low = ur.low;
+
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_shl(i64 a, int n)
+{
+  u64 ua;
+  u64 ur;
+  i64 res;
+
+  ua.low = a.low;
+  ua.high = (u32)a.high;
+
+  ur = u64_shl(ua, n);
+
+  res.low = ur.low;
+  res.high = (i32)ur.high;
+
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_shr(i64 a, int n)
+{
+#if defined(TYPES_SIMD_SSE2)
+  /* No 64-bit arithmetic shift in SSE2: shift logically and or in the sign */
+  u32 count = (u32)n & ~(0U - ((u32)n >> 31));
+  __m128i c = _mm_cvtsi32_si128((int)count);
+  __m128i sign = _mm_set1_epi32((i32)(0U - ((u32)a.high >> 31)));
+  __m128i fill = _mm_andnot_si128(_mm_srl_epi64(_mm_set1_epi32(-1), c), sign);
+  i64 res;
+  _mm_storel_epi64((__m128i *)(void *)&res, _mm_or_si128(_mm_srl_epi64(TYPES_SSE2_LOAD(a), c), fill));
+  return res;
+#elif defined(TYPES_SIMD_NEON)
+  /* SSHL with a negative count is an arithmetic right shift, by 64 it fills the sign */
+  i32 count = types_neon_shift_count(n);
+  u64 ua;
+  i64 res;
+  ua.high = (u32)a.high;
+  ua.low = a.low;
+  ua = types_neon_store(vreinterpret_u64_s64(vshl_s64(vreinterpret_s64_u64(types_neon_load(ua)), vdup_n_s64(-count))));
+  res.high = (i32)ua.high;
+  res.low = ua.low;
+  return res;
+#else
+  i64 res;
+  u32 high;
+  res.low = types_i64_shr_words((u32)a.high, a.low, n, &high);
+  res.high = (i32)high;
+  return res;
+#endif
+}
+
+TYPES_API TYPES_INLINE i64 i64_neg(i64 a)
+{
+  u64 zero = {0, 0};
+  u64 ua;
+  u64 ur;
+  i64 res;
+
+  ua.low = a.low;
+  ua.high = (u32)a.high;
+
+  ur = u64_sub(zero, ua);
+
+  res.low = ur.low;
+  res.high = (i32)ur.high;
+
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_mul(i64 a, i64 b)
+{
+  /* The low 64 bits of a two's complement product equal the unsigned product */
+  u64 ua, ub, ur;
+  i64 res;
+
+  ua.high = (u32)a.high;
+  ua.low = a.low;
+  ub.high = (u32)b.high;
+  ub.low = b.low;
+
+  ur = u64_mul(ua, ub);
+
+  res.high = (i32)ur.high;
+  res.low = ur.low;
+  return res;
+}
+
+/* Truncating division with a single unsigned division, the remainder has
+ * the sign of the dividend (like C99 / and %). The divisor must not be zero.
+ * I64_MIN / -1 wraps to I64_MIN with remainder 0.
+ */
+TYPES_API TYPES_INLINE i64 i64_divmod(i64 a, i64 b, i64 *remainder)
+{
+  u64 zero = {0, 0};
+  u64 ua, ub, uq, ur;
+  i64 res;
+
+  ua.high = (u32)a.high;
+  ua.low = a.low;
+  ub.high = (u32)b.high;
+  ub.low = b.low;
+
+  if (a.high < 0)
+  {
+    ua = u64_sub(zero, ua);
+  }
+  if (b.high < 0)
+  {
+    ub = u64_sub(zero, ub);
+  }
+
+  uq = u64_divmod(ua, ub, &ur);
+
+  if ((a.high < 0) != (b.high < 0))
+  {
+    uq = u64_sub(zero, uq);
+  }
+  if (a.high < 0)
+  {
+    ur = u64_sub(zero, ur);
+  }
+
+  remainder->high = (i32)ur.high;
+  remainder->low = ur.low;
+  res.high = (i32)uq.high;
+  res.low = uq.low;
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div(i64 a, i64 b)
+{
+  i64 remainder;
+  return i64_divmod(a, b, &remainder);
+}
+
+TYPES_API TYPES_INLINE i64 i64_mod(i64 a, i64 b)
+{
+  i64 remainder;
+  i64_divmod(a, b, &remainder);
+  return remainder;
+}
+
+/* Floored division: the quotient rounds towards negative infinity and the
+ * remainder has the sign of the divisor, e.g. for bucketing negative values.
+ */
+TYPES_API TYPES_INLINE i64 i64_divmod_floor(i64 a, i64 b, i64 *remainder)
+{
+  i64 q = i64_divmod(a, b, remainder);
+
+  if ((remainder->high != 0 || remainder->low != 0) && (remainder->high < 0) != (b.high < 0))
+  {
+    i64 minus_one = {0xFFFFFFFF, -1};
+    q = i64_add(q, minus_one);
+    *remainder = i64_add(*remainder, b);
+  }
+  return q;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div_floor(i64 a, i64 b)
+{
+  i64 remainder;
+  return i64_divmod_floor(a, b, &remainder);
+}
+
+TYPES_API TYPES_INLINE i64 i64_mod_floor(i64 a, i64 b)
+{
+  i64 remainder;
+  i64_divmod_floor(a, b, &remainder);
+  return remainder;
+}
+
+/* Euclidean division: the remainder is always in [0, |b|). */
+TYPES_API TYPES_INLINE i64 i64_divmod_euclid(i64 a, i64 b, i64 *remainder)
+{
+  i64 q = i64_divmod(a, b, remainder);
+
+  if (remainder->high < 0)
+  {
+    i64 one = {1, 0};
+    if (b.high < 0)
+    {
+      q = i64_add(q, one);
+      *remainder = i64_sub(*remainder, b);
+    }
+    else
+    {
+      q = i64_sub(q, one);
+      *remainder = i64_add(*remainder, b);
+    }
+  }
+  return q;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div_euclid(i64 a, i64 b)
+{
+  i64 remainder;
+  return i64_divmod_euclid(a, b, &remainder);
+}
+
+TYPES_API TYPES_INLINE i64 i64_mod_euclid(i64 a, i64 b)
+{
+  i64 remainder;
+  i64_divmod_euclid(a, b, &remainder);
+  return remainder;
+}
+
+/* ---- Signed Math (i64 with i32 operand) ---- */
+TYPES_API TYPES_INLINE i64 i64_add_i32(i64 a, i32 b)
+{
+  i64 res;
+  res.low = a.low + (u32)b;
+  res.high = (i32)((u32)a.high + (0U - ((u32)b >> 31)) + (res.low < (u32)b));
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_sub_i32(i64 a, i32 b)
+{
+  i64 res;
+  res.low = a.low - (u32)b;
+  res.high = (i32)((u32)a.high - (0U - ((u32)b >> 31)) - (a.low < (u32)b));
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_mul_i32(i64 a, i32 b)
+{
+  i64 res;
+  u32 high;
+
+  /* Low 64 bits of the two's complement product: a * (u32)b - (b < 0 ? a << 32 : 0) */
+  res.low = types_u32_mul_wide(a.low, (u32)b, &high);
+  high += (u32)a.high * (u32)b;
+  high -= a.low & (0U - ((u32)b >> 31));
+  res.high = (i32)high;
+  return res;
+}
+
+/* Truncating division, the remainder has the sign of the dividend. The divisor must not be zero. */
+TYPES_API TYPES_INLINE i64 i64_divmod_i32(i64 dividend, i32 divisor, i32 *remainder)
+{
+  u64 ua;
+  u64 uq;
+  u32 ur;
+  u32 ub = (divisor < 0) ? 0U - (u32)divisor : (u32)divisor;
+  i64 res;
+
+  ua.low = dividend.low;
+  ua.high = (u32)dividend.high;
+
+  if (dividend.high < 0)
+  {
+    u64 zero = {0, 0};
+    ua = u64_sub(zero, ua);
+  }
+
+  uq = u64_divmod_u32(ua, ub, &ur);
+
+  if ((dividend.high < 0) != (divisor < 0))
+  {
+    u64 zero = {0, 0};
+    uq = u64_sub(zero, uq);
+  }
+
+  *remainder = (dividend.high < 0) ? (i32)(0U - ur) : (i32)ur;
+
+  res.low = uq.low;
+  res.high = (i32)uq.high;
+  return res;
+}
+
+TYPES_API TYPES_INLINE i64 i64_div_i32(i64 dividend, i32 divisor)
+{
+  i32 remainder;
+  return i64_divmod_i32(dividend, divisor, &remainder);
+}
+
+TYPES_API TYPES_INLINE i32 i64_mod_i32(i64 dividend, i32 divisor)
+{
+  i32 remainder;
+  i64_divmod_i32(dividend, divisor, &remainder);
+  return remainder;
+}
+
+/* ---- Unsigned Comparisons ---- */
+TYPES_API TYPES_INLINE int u64_eq(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_SSE2)
+  return (_mm_movemask_epi8(_mm_cmpeq_epi32(TYPES_SSE2_LOAD(a), TYPES_SSE2_LOAD(b))) & 0xFF) == 0xFF;
+#elif defined(TYPES_SIMD_NEON) && defined(TYPES_SIMD_COMPARE)
+  return (int)(vget_lane_u64(vceq_u64(types_neon_load(a), types_neon_load(b)), 0) & 1);
+#elif defined(TYPES_BRANCHLESS)
+  return (int)(1U ^ TYPES_CT_NONZERO((a.high ^ b.high) | (a.low ^ b.low)));
+#else
+  return a.high == b.high && a.low == b.low;
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_ne(u64 a, u64 b)
+{
+  return !u64_eq(a, b);
+}
+
+TYPES_API TYPES_INLINE int u64_lt(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_SSE2)
+  /* SSE2 has no 64-bit compare: compare the 32-bit halves with the sign bit
+   * flipped (signed order == unsigned order) and combine high and low.
+   */
+  __m128i sign = _mm_set1_epi32(I32_MIN);
+  __m128i x = _mm_xor_si128(TYPES_SSE2_LOAD(a), sign);
+  __m128i y = _mm_xor_si128(TYPES_SSE2_LOAD(b), sign);
+  int gt = _mm_movemask_epi8(_mm_cmpgt_epi32(y, x));
+  int eq = _mm_movemask_epi8(_mm_cmpeq_epi32(x, y));
+  return ((gt >> 4) | ((eq >> 4) & gt)) & 1;
+#elif defined(TYPES_SIMD_NEON) && defined(TYPES_SIMD_COMPARE)
+  return (int)(vget_lane_u64(vclt_u64(types_neon_load(a), types_neon_load(b)), 0) & 1);
+#elif defined(TYPES_BRANCHLESS)
+  /* Borrow out of the two word subtraction a - b */
+  u32 borrow = ((~a.low & b.low) | (~(a.low ^ b.low) & (a.low - b.low))) >> 31;
+  u32 high = a.high - b.high - borrow;
+  return (int)(((~a.high & b.high) | (~(a.high ^ b.high) & high)) >> 31);
+#else
+  if (a.high < b.high)
+  {
+    return 1;
+  }
+  if (a.high > b.high)
+  {
+    return 0;
+  }
+  return a.low < b.low;
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_le(u64 a, u64 b)
+{
+#if defined(TYPES_SIMD_COMPARE)
+  return !u64_lt(b, a);
+#elif defined(TYPES_BRANCHLESS)
+  return (int)(1U ^ (u32)u64_lt(b, a));
+#else
+  if (a.high < b.high)
+  {
+    return 1;
+  }
+  if (a.high > b.high)
+  {
+    return 0;
+  }
+  return a.low <= b.low;
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_gt(u64 a, u64 b)
+{
+  return u64_lt(b, a);
+}
+
+TYPES_API TYPES_INLINE int u64_ge(u64 a, u64 b)
+{
+  return u64_le(b, a);
+}
+
+/* ---- Signed Comparisons ---- */
+TYPES_API TYPES_INLINE int i64_eq(i64 a, i64 b)
+{
+#ifdef TYPES_BRANCHLESS
+  return (int)(1U ^ TYPES_CT_NONZERO(((u32)a.high ^ (u32)b.high) | (a.low ^ b.low)));
+#else
+  return a.high == b.high && a.low == b.low;
+#endif
+}
+
+TYPES_API TYPES_INLINE int i64_ne(i64 a, i64 b)
+{
+  return !i64_eq(a, b);
+}
+
+TYPES_API TYPES_INLINE int i64_lt(i64 a, i64 b)
+{
+#if defined(TYPES_SIMD_COMPARE)
+  u64 ua;
+  u64 ub;
+  ua.high = (u32)a.high ^ 0x80000000;
+  ua.low = a.low;
+  ub.high = (u32)b.high ^ 0x80000000;
+  ub.low = b.low;
+  return u64_lt(ua, ub);
+#elif defined(TYPES_BRANCHLESS)
+  /* Flipping the sign bits maps the signed order onto the unsigned one */
+  u64 ua;
+  u64 ub;
+  ua.high = (u32)a.high ^ 0x80000000;
+  ua.low = a.low;
+  ub.high = (u32)b.high ^ 0x80000000;
+  ub.low = b.low;
+  return u64_lt(ua, ub);
+#else
+  if (a.high < b.high)
+  {
+    return 1;
+  }
+  if (a.high > b.high)
+  {
+    return 0;
+  }
+  return a.low < b.low;
+#endif
+}
+
+TYPES_API TYPES_INLINE int i64_le(i64 a, i64 b)
+{
+#if defined(TYPES_SIMD_COMPARE)
+  return !i64_lt(b, a);
+#elif defined(TYPES_BRANCHLESS)
+  return (int)(1U ^ (u32)i64_lt(b, a));
+#else
+  if (a.high < b.high)
+  {
+    return 1;
+  }
+  if (a.high > b.high)
+  {
+    return 0;
+  }
+  return a.low <= b.low;
+#endif
+}
+
+TYPES_API TYPES_INLINE int i64_gt(i64 a, i64 b)
+{
+  return i64_lt(b, a);
+}
+
+TYPES_API TYPES_INLINE int i64_ge(i64 a, i64 b)
+{
+  return i64_le(b, a);
+}
+
+/* Conversion functions */
+TYPES_API TYPES_INLINE u64 u64_from_u32(u32 x)
+{
+  u64 r;
+  r.high = 0;
+  r.low = x;
+  return r;
+}
+
+TYPES_API TYPES_INLINE i64 i64_from_i32(i32 x)
+{
+  i64 r;
+  r.high = (x < 0) ? -1 : 0;
+  r.low = (u32)x;
+  return r;
+}
+
+/* Both halves convert exactly, the sum is the only rounding */
+TYPES_API TYPES_INLINE double double_from_u64(u64 x)
+{
+  return (double)x.high * 4294967296.0 + (double)x.low;
+}
+
+/* x = high * 2^32 + low with a signed high word, no branch on the sign */
+TYPES_API TYPES_INLINE double double_from_i64(i64 x)
+{
+  return (double)x.high * 4294967296.0 + (double)x.low;
+}
+
+/* Construction and access of the two 32-bit words */
+TYPES_API TYPES_INLINE u64 u64_make(u32 high, u32 low)
+{
+  u64 r;
+  r.high = high;
+  r.low = low;
+  return r;
+}
+
+TYPES_API TYPES_INLINE u32 u64_high(u64 x)
+{
+  return x.high;
+}
+
+TYPES_API TYPES_INLINE u32 u64_low(u64 x)
+{
+  return x.low;
+}
+
+TYPES_API TYPES_INLINE i64 i64_make(i32 high, u32 low)
+{
+  i64 r;
+  r.high = high;
+  r.low = low;
+  return r;
+}
+
+TYPES_API TYPES_INLINE i32 i64_high(i64 x)
+{
+  return x.high;
+}
+
+TYPES_API TYPES_INLINE u32 i64_low(i64 x)
+{
+  return x.low;
+}
+
+/* Reinterpret the two's complement bit pattern */
+TYPES_API TYPES_INLINE u64 u64_from_i64(i64 x)
+{
+  u64 r;
+  r.high = (u32)x.high;
+  r.low = x.low;
+  return r;
+}
+
+TYPES_API TYPES_INLINE i64 i64_from_u64(u64 x)
+{
+  i64 r;
+  r.high = (i32)x.high;
+  r.low = x.low;
+  return r;
+}
+
+#endif /* TYPES_NATIVE64 */
+
+/* #############################################################################
+ * # 64-bit Bit Operations
+ * #############################################################################
+ *
+ * Same contract as the 32-bit versions: clz and ctz return 64 for zero and
+ * rotation counts are taken modulo 64. Native builds on GCC/Clang use the
+ * 64-bit builtins, everything else combines the 32-bit operations on the
+ * high and low word.
+ */
+TYPES_API TYPES_INLINE int u64_popcount(u64 x)
+{
+#if defined(TYPES_NATIVE64) && (defined(__GNUC__) || defined(__clang__)) && defined(__POPCNT__)
+  return __builtin_popcountll(x);
+#else
+  return u32_popcount(u64_high(x)) + u32_popcount(u64_low(x));
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_clz(u64 x)
+{
+#if defined(TYPES_NATIVE64) && (defined(__GNUC__) || defined(__clang__))
+  return x ? __builtin_clzll(x) : 64;
+#else
+  u32 high = u64_high(x);
+  return high ? u32_clz(high) : 32 + u32_clz(u64_low(x));
+#endif
+}
+
+TYPES_API TYPES_INLINE int u64_ctz(u64 x)
+{
+#if defined(TYPES_NATIVE64) && (defined(__GNUC__) || defined(__clang__))
+  return x ? __builtin_ctzll(x) : 64;
+#else
+  u32 low = u64_low(x);
+  return low ? u32_ctz(low) : 32 + u32_ctz(u64_high(x));
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_bswap(u64 x)
+{
+#if defined(TYPES_NATIVE64) && (defined(__GNUC__) || defined(__clang__))
+  return __builtin_bswap64(x);
+#else
+  return u64_make(u32_bswap(u64_low(x)), u32_bswap(u64_high(x)));
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_rotl(u64 x, int n)
+{
+#ifdef TYPES_NATIVE64
+  u32 s = (u32)n & 63;
+  return (x << s) | (x >> ((64 - s) & 63));
+#else
+  /* Swap the words for counts >= 32, then rotate both by the rest */
+  u32 s = (u32)n & 31;
+  u32 high = ((u32)n & 32) ? x.low : x.high;
+  u32 low = ((u32)n & 32) ? x.high : x.low;
+  u64 res;
+  res.high = (high << s) | ((low >> 1) >> (31 - s));
+  res.low = (low << s) | ((high >> 1) >> (31 - s));
+  return res;
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_rotr(u64 x, int n)
+{
+  return u64_rotl(x, 64 - ((int)((u32)n & 63)));
+}
+
+/* #############################################################################
+ * # Endian Loads and Stores
+ * #############################################################################
+ *
+ * Read and write little/big-endian integers at any address of a byte buffer,
+ * e.g. to parse file and network formats in place. The byte shifts are
+ * correct on strict-alignment and big-endian CPUs. GCC and clang combine
+ * them into a single load or store (plus bswap/movbe for the other byte
+ * order), MSVC on x86/x64 gets the unaligned access spelled out.
+ *
+ * The u64 variants return the native or emulated u64 alike.
+ */
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define TYPES_LOAD_STORE_X86
+#endif
+
+TYPES_API TYPES_INLINE u16 u16_bswap(u16 x)
+{
+  return (u16)((x >> 8) | (x << 8));
+}
+
+TYPES_API TYPES_INLINE u16 u16_load_le(const u8 *p)
+{
+#ifdef TYPES_LOAD_STORE_X86
+  return *(const u16 *)p;
+#else
+  return (u16)(p[0] | (p[1] << 8));
+#endif
+}
+
+TYPES_API TYPES_INLINE u16 u16_load_be(const u8 *p)
+{
+  return (u16)((p[0] << 8) | p[1]);
+}
+
+TYPES_API TYPES_INLINE u32 u32_load_le(const u8 *p)
+{
+#ifdef TYPES_LOAD_STORE_X86
+  return *(const u32 *)p;
+#else
+  return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+#endif
+}
+
+TYPES_API TYPES_INLINE u32 u32_load_be(const u8 *p)
+{
+#ifdef TYPES_LOAD_STORE_X86
+  return u32_bswap(*(const u32 *)p);
+#else
+  return ((u32)p[0] << 24) | ((u32)p[1] << 16) | ((u32)p[2] << 8) | (u32)p[3];
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_load_le(const u8 *p)
+{
+#if defined(TYPES_LOAD_STORE_X86) && defined(TYPES_NATIVE64)
+  return *(const u64 *)p;
+#else
+  return u64_make(u32_load_le(p + 4), u32_load_le(p));
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_load_be(const u8 *p)
+{
+#if defined(TYPES_LOAD_STORE_X86) && defined(TYPES_NATIVE64)
+  return u64_bswap(*(const u64 *)p);
+#else
+  return u64_make(u32_load_be(p), u32_load_be(p + 4));
+#endif
+}
+
+TYPES_API TYPES_INLINE void u16_store_le(u8 *p, u16 x)
+{
+  p[0] = (u8)x;
+  p[1] = (u8)(x >> 8);
+}
+
+TYPES_API TYPES_INLINE void u16_store_be(u8 *p, u16 x)
+{
+  p[0] = (u8)(x >> 8);
+  p[1] = (u8)x;
+}
+
+TYPES_API TYPES_INLINE void u32_store_le(u8 *p, u32 x)
+{
+#ifdef TYPES_LOAD_STORE_X86
+  *(u32 *)p = x;
+#else
+  p[0] = (u8)x;
+  p[1] = (u8)(x >> 8);
+  p[2] = (u8)(x >> 16);
+  p[3] = (u8)(x >> 24);
+#endif
+}
+
+TYPES_API TYPES_INLINE void u32_store_be(u8 *p, u32 x)
+{
+#ifdef TYPES_LOAD_STORE_X86
+  *(u32 *)p = u32_bswap(x);
+#else
+  p[0] = (u8)(x >> 24);
+  p[1] = (u8)(x >> 16);
+  p[2] = (u8)(x >> 8);
+  p[3] = (u8)x;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_store_le(u8 *p, u64 x)
+{
+  u32_store_le(p, u64_low(x));
+  u32_store_le(p + 4, u64_high(x));
+}
+
+TYPES_API TYPES_INLINE void u64_store_be(u8 *p, u64 x)
+{
+  u32_store_be(p, u64_high(x));
+  u32_store_be(p + 4, u64_low(x));
+}
+
+/* ---- Arrays ---- */
+
+/* Byte swap count values in place, e.g. after reading a big-endian table */
+TYPES_API TYPES_INLINE void u16_bswap_n(u16 *values, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    values[i] = u16_bswap(values[i]);
+  }
+}
+
+TYPES_API TYPES_INLINE void u32_bswap_n(u32 *values, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    values[i] = u32_bswap(values[i]);
+  }
+}
+
+TYPES_API TYPES_INLINE void u64_bswap_n(u64 *values, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    values[i] = u64_bswap(values[i]);
+  }
+}
+
+/* #############################################################################
+ * # 64-bit Integer Operations (pointer arguments)
+ * #############################################################################
+ *
+ * Same operations as above but operands and result are passed by pointer.
+ * On ABIs like i386 cdecl this avoids copying the structs onto the stack and
+ * the hidden return pointer when a call is not inlined: the emulated versions
+ * work on the words directly instead of calling the by-value operations. The
+ * words are loaded before the result is stored, so the result may alias any
+ * operand, e.g. u64_add_to(&sum, &sum, &value).
+ */
+/* ---- Bitwise Operators (Unsigned) ---- */
+TYPES_API TYPES_INLINE void u64_and_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a & *b;
+#else
+  u32 high = a->high & b->high;
+  u32 low = a->low & b->low;
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_or_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a | *b;
+#else
+  u32 high = a->high | b->high;
+  u32 low = a->low | b->low;
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_xor_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a ^ *b;
+#else
+  u32 high = a->high ^ b->high;
+  u32 low = a->low ^ b->low;
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_not_to(u64 *r, const u64 *a)
+{
+#ifdef TYPES_NATIVE64
+  *r = ~*a;
+#else
+  r->high = ~a->high;
+  r->low = ~a->low;
+#endif
+}
+
+/* ---- Unsigned Math ---- */
+TYPES_API TYPES_INLINE void u64_add_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a + *b;
+#else
+  u32 a_low = a->low;
+  u32 low = a_low + b->low;
+  u32 high = a->high + b->high + (u32)(low < a_low);
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_sub_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a - *b;
+#else
+  u32 a_low = a->low;
+  u32 b_low = b->low;
+  u32 high = a->high - b->high - (u32)(a_low < b_low);
+  r->high = high;
+  r->low = a_low - b_low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_mul_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a * *b;
+#else
+  u32 a_low = a->low, a_high = a->high;
+  u32 b_low = b->low, b_high = b->high;
+  u32 high;
+  u32 low = types_u32_mul_wide(a_low, b_low, &high);
+  r->high = high + a_high * b_low + a_low * b_high;
+  r->low = low;
+#endif
+}
+
+#ifndef TYPES_NATIVE64
+/* u64_divmod for the pointer variants. The u32 divisor cases run on the
+ * words, only the general case (a quotient below 2^32) calls u64_divmod.
+ */
+TYPES_API TYPES_INLINE void types_u64_divmod_to(u64 *q, u64 *remainder, const u64 *a, const u64 *b)
+{
+  u32 a_low = a->low, a_high = a->high;
+  u32 b_low = b->low, b_high = b->high;
+
+  if (b_high != 0)
+  {
+    *q = u64_divmod(*a, *b, remainder);
+  }
+  else if (a_high == 0)
+  {
+    q->high = 0;
+    q->low = a_low / b_low;
+    remainder->high = 0;
+    remainder->low = a_low % b_low;
+  }
+  else
+  {
+    q->high = a_high / b_low;
+    q->low = types_u32_divlu(a_high % b_low, a_low, b_low, &remainder->low);
+    remainder->high = 0;
+  }
+}
+#endif
+
+TYPES_API TYPES_INLINE void u64_div_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a / *b;
+#else
+  u64 q, remainder;
+  types_u64_divmod_to(&q, &remainder, a, b);
+  *r = q;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_mod_to(u64 *r, const u64 *a, const u64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a % *b;
+#else
+  u64 q, remainder;
+  types_u64_divmod_to(&q, &remainder, a, b);
+  *r = remainder;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_shl_to(u64 *r, const u64 *a, int n)
+{
+#ifdef TYPES_NATIVE64
+  *r = u64_shl(*a, n);
+#else
+  u32 high;
+  u32 low = types_u64_shl_words(a->high, a->low, n, &high);
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_shr_to(u64 *r, const u64 *a, int n)
+{
+#ifdef TYPES_NATIVE64
+  *r = u64_shr(*a, n);
+#else
+  u32 high;
+  u32 low = types_u64_shr_words(a->high, a->low, n, &high);
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_add_u32_to(u64 *r, const u64 *a, u32 b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a + b;
+#else
+  u32 low = a->low + b;
+  r->high = a->high + (u32)(low < b);
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_sub_u32_to(u64 *r, const u64 *a, u32 b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a - b;
+#else
+  u32 a_low = a->low;
+  r->high = a->high - (u32)(a_low < b);
+  r->low = a_low - b;
+#endif
+}
+
+TYPES_API TYPES_INLINE void u64_mul_u32_to(u64 *r, const u64 *a, u32 b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a * b;
+#else
+  u32 a_high = a->high;
+  u32 high;
+  u32 low = types_u32_mul_wide(a->low, b, &high);
+  r->high = high + a_high * b;
+  r->low = low;
+#endif
+}
+
+/* ---- Bitwise Operators (Signed) ---- */
+TYPES_API TYPES_INLINE void i64_and_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a & *b;
+#else
+  i32 high = a->high & b->high;
+  u32 low = a->low & b->low;
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_or_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a | *b;
+#else
+  i32 high = a->high | b->high;
+  u32 low = a->low | b->low;
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_xor_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = *a ^ *b;
+#else
+  i32 high = a->high ^ b->high;
+  u32 low = a->low ^ b->low;
+  r->high = high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_not_to(i64 *r, const i64 *a)
+{
+#ifdef TYPES_NATIVE64
+  *r = ~*a;
+#else
+  r->high = ~a->high;
+  r->low = ~a->low;
+#endif
+}
+
+/* ---- Signed Math ---- */
+/* Two's complement on the words: the same carries and borrows as u64 */
+TYPES_API TYPES_INLINE void i64_add_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = (i64)((u64)*a + (u64)*b);
+#else
+  u32 a_low = a->low;
+  u32 low = a_low + b->low;
+  u32 high = (u32)a->high + (u32)b->high + (u32)(low < a_low);
+  r->high = (i32)high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_sub_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = (i64)((u64)*a - (u64)*b);
+#else
+  u32 a_low = a->low;
+  u32 b_low = b->low;
+  u32 high = (u32)a->high - (u32)b->high - (u32)(a_low < b_low);
+  r->high = (i32)high;
+  r->low = a_low - b_low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_mul_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = (i64)((u64)*a * (u64)*b);
+#else
+  u32 a_low = a->low, a_high = (u32)a->high;
+  u32 b_low = b->low, b_high = (u32)b->high;
+  u32 high;
+  u32 low = types_u32_mul_wide(a_low, b_low, &high);
+  r->high = (i32)(high + a_high * b_low + a_low * b_high);
+  r->low = low;
+#endif
+}
+
+#ifndef TYPES_NATIVE64
+/* i64_divmod for the pointer variants: divide the magnitudes, then apply the signs */
+TYPES_API TYPES_INLINE void types_i64_divmod_to(i64 *q, i64 *remainder, const i64 *a, const i64 *b)
+{
+  u32 a_low = a->low, a_high = (u32)a->high;
+  u32 b_low = b->low, b_high = (u32)b->high;
+  u32 a_neg = a_high >> 31;
+  u32 q_neg = a_neg ^ (b_high >> 31);
+  u64 ua, ub, uq, ur;
+
+  ua.high = a_neg ? 0U - a_high - (u32)(a_low != 0) : a_high;
+  ua.low = a_neg ? 0U - a_low : a_low;
+  ub.high = (b_high >> 31) ? 0U - b_high - (u32)(b_low != 0) : b_high;
+  ub.low = (b_high >> 31) ? 0U - b_low : b_low;
+
+  types_u64_divmod_to(&uq, &ur, &ua, &ub);
+
+  q->high = (i32)(q_neg ? 0U - uq.high - (u32)(uq.low != 0) : uq.high);
+  q->low = q_neg ? 0U - uq.low : uq.low;
+  remainder->high = (i32)(a_neg ? 0U - ur.high - (u32)(ur.low != 0) : ur.high);
+  remainder->low = a_neg ? 0U - ur.low : ur.low;
+}
+#endif
+
+TYPES_API TYPES_INLINE void i64_div_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = i64_div(*a, *b);
+#else
+  i64 q, remainder;
+  types_i64_divmod_to(&q, &remainder, a, b);
+  *r = q;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_mod_to(i64 *r, const i64 *a, const i64 *b)
+{
+#ifdef TYPES_NATIVE64
+  *r = i64_mod(*a, *b);
+#else
+  i64 q, remainder;
+  types_i64_divmod_to(&q, &remainder, a, b);
+  *r = remainder;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_neg_to(i64 *r, const i64 *a)
+{
+#ifdef TYPES_NATIVE64
+  *r = (i64)(0 - (u64)*a);
+#else
+  u32 low = a->low;
+  r->high = (i32)(0U - (u32)a->high - (u32)(low != 0));
+  r->low = 0U - low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_shl_to(i64 *r, const i64 *a, int n)
+{
+#ifdef TYPES_NATIVE64
+  *r = i64_shl(*a, n);
+#else
+  u32 high;
+  u32 low = types_u64_shl_words((u32)a->high, a->low, n, &high);
+  r->high = (i32)high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_shr_to(i64 *r, const i64 *a, int n)
+{
+#ifdef TYPES_NATIVE64
+  *r = i64_shr(*a, n);
+#else
+  u32 high;
+  u32 low = types_i64_shr_words((u32)a->high, a->low, n, &high);
+  r->high = (i32)high;
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_add_i32_to(i64 *r, const i64 *a, i32 b)
+{
+#ifdef TYPES_NATIVE64
+  *r = (i64)((u64)*a + (u64)(i64)b);
+#else
+  u32 low = a->low + (u32)b;
+  r->high = (i32)((u32)a->high + (0U - ((u32)b >> 31)) + (u32)(low < (u32)b));
+  r->low = low;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_sub_i32_to(i64 *r, const i64 *a, i32 b)
+{
+#ifdef TYPES_NATIVE64
+  *r = (i64)((u64)*a - (u64)(i64)b);
+#else
+  u32 a_low = a->low;
+  r->high = (i32)((u32)a->high - (0U - ((u32)b >> 31)) - (u32)(a_low < (u32)b));
+  r->low = a_low - (u32)b;
+#endif
+}
+
+TYPES_API TYPES_INLINE void i64_mul_i32_to(i64 *r, const i64 *a, i32 b)
+{
+#ifdef TYPES_NATIVE64
+  *r = (i64)((u64)*a * (u64)(i64)b);
+#else
+  /* Low 64 bits of the two's complement product, see i64_mul_i32 */
+  u32 a_low = a->low;
+  u32 high;
+  u32 low = types_u32_mul_wide(a_low, (u32)b, &high);
+  high += (u32)a->high * (u32)b;
+  high -= a_low & (0U - ((u32)b >> 31));
+  r->high = (i32)high;
+  r->low = low;
+#endif
+}
+
+/* #############################################################################
+ * # 64-bit Integer Operations (arrays)
+ * #############################################################################
+ *
+ * Apply one operation to count elements: r[i] = a[i] op b[i]. The emulated
+ * versions work on the u32 limbs directly (carries and borrows as compares,
+ * no branches) so the compiler can vectorize the loops in both modes.
+ * r must not overlap a or b (restrict), in-place updates need a copy.
+ * The sums at the end reduce or scan a whole array.
+ */
+/* ---- Bitwise Operators (Unsigned) ---- */
+TYPES_API TYPES_INLINE void u64_and_n(u64 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = a[i] & b[i];
+#else
+    r[i].low = a[i].low & b[i].low;
+    r[i].high = a[i].high & b[i].high;
+#endif
+  }
+}
+
+TYPES_API TYPES_INLINE void u64_or_n(u64 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = a[i] | b[i];
+#else
+    r[i].low = a[i].low | b[i].low;
+    r[i].high = a[i].high | b[i].high;
+#endif
+  }
+}
+
+TYPES_API TYPES_INLINE void u64_xor_n(u64 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = a[i] ^ b[i];
+#else
+    r[i].low = a[i].low ^ b[i].low;
+    r[i].high = a[i].high ^ b[i].high;
+#endif
+  }
+}
+
+/* ---- Unsigned Math ---- */
+TYPES_API TYPES_INLINE void u64_add_n(u64 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = a[i] + b[i];
+#else
+    u32 low = a[i].low + b[i].low;
+    r[i].high = a[i].high + b[i].high + (u32)(low < a[i].low);
+    r[i].low = low;
+#endif
+  }
+}
+
+TYPES_API TYPES_INLINE void u64_sub_n(u64 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = a[i] - b[i];
+#else
+    r[i].high = a[i].high - b[i].high - (u32)(a[i].low < b[i].low);
+    r[i].low = a[i].low - b[i].low;
+#endif
+  }
+}
+
+TYPES_API TYPES_INLINE void u64_mul_n(u64 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = a[i] * b[i];
+#else
+    u32 high;
+    u32 low = types_u32_mul_wide(a[i].low, b[i].low, &high);
+    r[i].high = high + a[i].high * b[i].low + a[i].low * b[i].high;
+    r[i].low = low;
+#endif
+  }
+}
+
+/* ---- Unsigned Comparisons ---- */
+/* m[i] = 1 if a[i] == b[i], 0 otherwise */
+TYPES_API TYPES_INLINE void u64_cmp_eq_n(b8 *TYPES_RESTRICT m, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    m[i] = (b8)(a[i] == b[i]);
+#else
+    m[i] = (b8)((a[i].low == b[i].low) & (a[i].high == b[i].high));
+#endif
+  }
+}
+
+/* m[i] = 1 if a[i] < b[i], 0 otherwise */
+TYPES_API TYPES_INLINE void u64_cmp_lt_n(b8 *TYPES_RESTRICT m, const u64 *TYPES_RESTRICT a, const u64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    m[i] = (b8)(a[i] < b[i]);
+#else
+    m[i] = (b8)((a[i].high < b[i].high) | ((a[i].high == b[i].high) & (a[i].low < b[i].low)));
+#endif
+  }
+}
+
+/* ---- Signed Math ---- */
+TYPES_API TYPES_INLINE void i64_add_n(i64 *TYPES_RESTRICT r, const i64 *TYPES_RESTRICT a, const i64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = i64_add(a[i], b[i]);
+#else
+    u32 low = a[i].low + b[i].low;
+    r[i].high = (i32)((u32)a[i].high + (u32)b[i].high + (u32)(low < a[i].low));
+    r[i].low = low;
+#endif
+  }
+}
+
+TYPES_API TYPES_INLINE void i64_sub_n(i64 *TYPES_RESTRICT r, const i64 *TYPES_RESTRICT a, const i64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = i64_sub(a[i], b[i]);
+#else
+    r[i].high = (i32)((u32)a[i].high - (u32)b[i].high - (u32)(a[i].low < b[i].low));
+    r[i].low = a[i].low - b[i].low;
+#endif
+  }
+}
+
+TYPES_API TYPES_INLINE void i64_mul_n(i64 *TYPES_RESTRICT r, const i64 *TYPES_RESTRICT a, const i64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    r[i] = i64_mul(a[i], b[i]);
+#else
+    u32 high;
+    u32 low = types_u32_mul_wide(a[i].low, b[i].low, &high);
+    r[i].high = (i32)(high + (u32)a[i].high * b[i].low + a[i].low * (u32)b[i].high);
+    r[i].low = low;
+#endif
+  }
+}
+
+/* ---- Signed Comparisons ---- */
+/* m[i] = 1 if a[i] == b[i], 0 otherwise */
+TYPES_API TYPES_INLINE void i64_cmp_eq_n(b8 *TYPES_RESTRICT m, const i64 *TYPES_RESTRICT a, const i64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    m[i] = (b8)(a[i] == b[i]);
+#else
+    m[i] = (b8)((a[i].low == b[i].low) & (a[i].high == b[i].high));
+#endif
+  }
+}
+
+/* m[i] = 1 if a[i] < b[i], 0 otherwise */
+TYPES_API TYPES_INLINE void i64_cmp_lt_n(b8 *TYPES_RESTRICT m, const i64 *TYPES_RESTRICT a, const i64 *TYPES_RESTRICT b, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+#ifdef TYPES_NATIVE64
+    m[i] = (b8)(a[i] < b[i]);
+#else
+    m[i] = (b8)((a[i].high < b[i].high) | ((a[i].high == b[i].high) & (a[i].low < b[i].low)));
+#endif
+  }
+}
+
+/* ---- Sums ---- */
+#ifndef TYPES_NATIVE64
+/* Normalizes carry-save lanes holding the bits at offsets 0, 16 and 32 */
+TYPES_API TYPES_INLINE u64 types_u64_from_lanes(u32 lane0, u32 lane16, u32 lane32)
+{
+  u64 res;
+  res.low = lane0 + (lane16 << 16);
+  res.high = lane32 + (lane16 >> 16) + (u32)(res.low < lane0);
+  return res;
+}
+#endif
+
+/* Sum of count u64 values (modulo 2^64).
+ *
+ * The emulated version splits the low words into 16-bit halves and adds them
+ * into independent lanes without a carry chain. The carries are resolved once
+ * every 65536 elements, the most a 16-bit lane can hold.
+ */
+TYPES_API TYPES_INLINE u64 u64_sum_n(const u64 *a, u32 count)
+{
+#ifdef TYPES_NATIVE64
+  u64 sum = 0;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    sum += a[i];
+  }
+  return sum;
+#else
+  u64 sum = u64_make(0, 0);
+
+  while (count > 0)
+  {
+    u32 block = (count < 65536U) ? count : 65536U;
+    u32 lane0 = 0;
+    u32 lane16 = 0;
+    u32 lane32 = 0;
+    u32 i;
+
+    for (i = 0; i < block; ++i)
+    {
+      lane0 += a[i].low & 0xFFFF;
+      lane16 += a[i].low >> 16;
+      lane32 += a[i].high;
+    }
+
+    sum = u64_add(sum, types_u64_from_lanes(lane0, lane16, lane32));
+    a += block;
+    count -= block;
+  }
+  return sum;
+#endif
+}
+
+/* Sum of count u32 values widened to u64, e.g. for byte counters */
+TYPES_API TYPES_INLINE u64 u32_sum_u64(const u32 *a, u32 count)
+{
+#ifdef TYPES_NATIVE64
+  u64 sum = 0;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    sum += a[i];
+  }
+  return sum;
+#else
+  u64 sum = u64_make(0, 0);
+
+  while (count > 0)
+  {
+    u32 block = (count < 65536U) ? count : 65536U;
+    u32 lane0 = 0;
+    u32 lane16 = 0;
+    u32 i;
+
+    for (i = 0; i < block; ++i)
+    {
+      lane0 += a[i] & 0xFFFF;
+      lane16 += a[i] >> 16;
+    }
+
+    sum = u64_add(sum, types_u64_from_lanes(lane0, lane16, 0));
+    a += block;
+    count -= block;
+  }
+  return sum;
+#endif
+}
+
+/* Dot product of two u32 arrays with a u64 result (modulo 2^64).
+ *
+ * The emulated version adds the 16x16 bit partial products into lanes at bit
+ * offsets 0, 16 and 32. The 16 bit lane grows by at most 3 * 0xFFFF per
+ * element, so carries are resolved every 21845 elements. The lane at 32 may
+ * wrap since it only feeds the high word.
+ */
+TYPES_API TYPES_INLINE u64 u32_dot_u64(const u32 *a, const u32 *b, u32 count)
+{
+#ifdef TYPES_NATIVE64
+  u64 sum = 0;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    sum += (u64)a[i] * b[i];
+  }
+  return sum;
+#else
+  u64 sum = u64_make(0, 0);
+
+  while (count > 0)
+  {
+    u32 block = (count < 21845U) ? count : 21845U;
+    u32 lane0 = 0;
+    u32 lane16 = 0;
+    u32 lane32 = 0;
+    u32 i;
+
+    for (i = 0; i < block; ++i)
+    {
+      u32 a_low = a[i] & 0xFFFF, a_high = a[i] >> 16;
+      u32 b_low = b[i] & 0xFFFF, b_high = b[i] >> 16;
+
+      u32 low_low = a_low * b_low;
+      u32 low_high = a_low * b_high;
+      u32 high_low = a_high * b_low;
+
+      lane0 += low_low & 0xFFFF;
+      lane16 += (low_low >> 16) + (low_high & 0xFFFF) + (high_low & 0xFFFF);
+      lane32 += a_high * b_high + (low_high >> 16) + (high_low >> 16);
+    }
+
+    sum = u64_add(sum, types_u64_from_lanes(lane0, lane16, lane32));
+    a += block;
+    b += block;
+    count -= block;
+  }
+  return sum;
+#endif
+}
+
+/* Inclusive prefix sum r[i] = a[0] + ... + a[i]. r may be the same array as a. */
+TYPES_API TYPES_INLINE void u64_prefix_sum_n(u64 *r, const u64 *a, u32 count)
+{
+#ifdef TYPES_NATIVE64
+  u64 sum = 0;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    sum += a[i];
+    r[i] = sum;
+  }
+#else
+  /* The running sum stays in two registers, only the carry is serial */
+  u32 low = 0;
+  u32 high = 0;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    u32 next = low + a[i].low;
+    high += a[i].high + (u32)(next < low);
+    low = next;
+    r[i].low = low;
+    r[i].high = high;
+  }
+#endif
+}
+
+/* #############################################################################
+ * # 128-bit Integer Types
+ * #############################################################################
+ *
+ * Maps onto the compilers __int128 when available (define TYPES_DISABLE_INT128
+ * to opt out). Otherwise u128/i128 are emulated with four u32 limbs where
+ * limb[0] is the least significant one. i128 uses two's complement.
+ */
+#if defined(__SIZEOF_INT128__) && !defined(TYPES_DISABLE_INT128)
+#define TYPES_NATIVE128
+
+__extension__ typedef unsigned __int128 u128;
+__extension__ typedef __int128 i128;
+
+TYPES_STATIC_ASSERT(sizeof(u128) == 16, u128_size_must_be_16);
+TYPES_STATIC_ASSERT(sizeof(i128) == 16, i128_size_must_be_16);
+
+/* ---- Conversions ---- */
+TYPES_API TYPES_INLINE u128 u128_make(u64 high, u64 low)
+{
+  return ((u128)u64_high(high) << 96) | ((u128)u64_low(high) << 64) |
+         ((u128)u64_high(low) << 32) | (u128)u64_low(low);
+}
+
+TYPES_API TYPES_INLINE u128 u128_from_u64(u64 x)
+{
+  return ((u128)u64_high(x) << 32) | (u128)u64_low(x);
+}
+
+TYPES_API TYPES_INLINE u64 u128_low(u128 x)
+{
+  return u64_make((u32)(x >> 32), (u32)x);
+}
+
+TYPES_API TYPES_INLINE u64 u128_high(u128 x)
+{
+  return u64_make((u32)(x >> 96), (u32)(x >> 64));
+}
+
+TYPES_API TYPES_INLINE i128 i128_from_i64(i64 x)
+{
+  /* Sign extend bit 63 */
+  return (i128)((u128_from_u64(u64_from_i64(x)) ^ ((u128)1 << 63)) - ((u128)1 << 63));
+}
+
+TYPES_API TYPES_INLINE i128 i128_from_u128(u128 x)
+{
+  return (i128)x;
+}
+
+TYPES_API TYPES_INLINE u128 u128_from_i128(i128 x)
+{
+  return (u128)x;
+}
+
+/* ---- Unsigned Math ---- */
+TYPES_API TYPES_INLINE u128 u128_add(u128 a, u128 b)
+{
+  return a + b;
+}
+
+TYPES_API TYPES_INLINE u128 u128_sub(u128 a, u128 b)
+{
+  return a - b;
+}
+
+TYPES_API TYPES_INLINE u128 u128_shl(u128 a, int n)
+{
+  return (n >= 128) ? 0 : (n > 0) ? a << n : a;
+}
+
+TYPES_API TYPES_INLINE u128 u128_shr(u128 a, int n)
+{
+  return (n >= 128) ? 0 : (n > 0) ? a >> n : a;
+}
+
+/* ---- Signed Math ---- */
+TYPES_API TYPES_INLINE i128 i128_add(i128 a, i128 b)
+{
+  return (i128)((u128)a + (u128)b);
+}
+
+TYPES_API TYPES_INLINE i128 i128_sub(i128 a, i128 b)
+{
+  return (i128)((u128)a - (u128)b);
+}
+
+TYPES_API TYPES_INLINE i128 i128_neg(i128 a)
+{
+  return (i128)(0 - (u128)a);
+}
+
+TYPES_API TYPES_INLINE i128 i128_shl(i128 a, int n)
+{
+  return (i128)u128_shl((u128)a, n);
+}
+
+TYPES_API TYPES_INLINE i128 i128_shr(i128 a, int n)
+{
+  return (n >= 128) ? ((a < 0) ? -1 : 0) : (n > 0) ? a >> n : a;
+}
+
+/* ---- Comparisons ---- */
+TYPES_API TYPES_INLINE int u128_eq(u128 a, u128 b)
+{
+  return a == b;
+}
+
+TYPES_API TYPES_INLINE int u128_lt(u128 a, u128 b)
+{
+  return a < b;
+}
+
+TYPES_API TYPES_INLINE int u128_le(u128 a, u128 b)
+{
+  return a <= b;
+}
+
+TYPES_API TYPES_INLINE int i128_eq(i128 a, i128 b)
+{
+  return a == b;
+}
+
+TYPES_API TYPES_INLINE int i128_lt(i128 a, i128 b)
+{
+  return a < b;
+}
+
+TYPES_API TYPES_INLINE int i128_le(i128 a, i128 b)
+{
+  return a <= b;
+}
+
+/* ---- Widening Multiplication ---- */
+TYPES_API TYPES_INLINE u128 u64_mul_wide(u64 a, u64 b)
+{
+  return u128_from_u64(a) * u128_from_u64(b);
+}
+
+TYPES_API TYPES_INLINE i128 i64_mul_wide(i64 a, i64 b)
+{
+  return i128_from_i64(a) * i128_from_i64(b);
+}
+
+#else
+
+typedef struct u128
+{
+  u32 limb[4];
+} u128;
+
+typedef struct i128
+{
+  u32 limb[4];
+} i128;
+
+TYPES_STATIC_ASSERT(sizeof(u128) == 16, u128_size_must_be_16);
+TYPES_STATIC_ASSERT(sizeof(i128) == 16, i128_size_must_be_16);
+
+/* ---- Conversions ---- */
+TYPES_API TYPES_INLINE u128 u128_make(u64 high, u64 low)
+{
+  u128 r;
+  r.limb[0] = u64_low(low);
+  r.limb[1] = u64_high(low);
+  r.limb[2] = u64_low(high);
+  r.limb[3] = u64_high(high);
+  return r;
+}
+
+TYPES_API TYPES_INLINE u128 u128_from_u64(u64 x)
+{
+  u128 r;
+  r.limb[0] = u64_low(x);
+  r.limb[1] = u64_high(x);
+  r.limb[2] = 0;
+  r.limb[3] = 0;
+  return r;
+}
+
+TYPES_API TYPES_INLINE u64 u128_low(u128 x)
+{
+  return u64_make(x.limb[1], x.limb[0]);
+}
+
+TYPES_API TYPES_INLINE u64 u128_high(u128 x)
+{
+  return u64_make(x.limb[3], x.limb[2]);
+}
+
+TYPES_API TYPES_INLINE i128 i128_from_i64(i64 x)
+{
+  i128 r;
+  u64 ux = u64_from_i64(x);
+  r.limb[0] = u64_low(ux);
+  r.limb[1] = u64_high(ux);
+  r.limb[2] = 0U - (r.limb[1] >> 31);
+  r.limb[3] = r.limb[2];
+  return r;
+}
+
+TYPES_API TYPES_INLINE i128 i128_from_u128(u128 x)
+{
+  i128 r;
+  r.limb[0] = x.limb[0];
+  r.limb[1] = x.limb[1];
+  r.limb[2] = x.limb[2];
+  r.limb[3] = x.limb[3];
+  return r;
+}
+
+TYPES_API TYPES_INLINE u128 u128_from_i128(i128 x)
+{
+  u128 r;
+  r.limb[0] = x.limb[0];
+  r.limb[1] = x.limb[1];
+  r.limb[2] = x.limb[2];
+  r.limb[3] = x.limb[3];
+  return r;
+}
+
+/* ---- Unsigned Math ---- */
+TYPES_API TYPES_INLINE u128 u128_add(u128 a, u128 b)
+{
+  u128 r;
+  u32 carry;
+  u32 t;
+
+  r.limb[0] = a.limb[0] + b.limb[0];
+  carry = r.limb[0] < a.limb[0];
+
+  t = a.limb[1] + carry;
+  carry = t < carry;
+  r.limb[1] = t + b.limb[1];
+  carry += r.limb[1] < t;
+
+  t = a.limb[2] + carry;
+  carry = t < carry;
+  r.limb[2] = t + b.limb[2];
+  carry += r.limb[2] < t;
+
+  r.limb[3] = a.limb[3] + b.limb[3] + carry;
+  return r;
+}
+
+TYPES_API TYPES_INLINE u128 u128_sub(u128 a, u128 b)
+{
+  u128 r;
+  u32 borrow;
+  u32 t;
+
+  r.limb[0] = a.limb[0] - b.limb[0];
+  borrow = a.limb[0] < b.limb[0];
+
+  t = a.limb[1] - borrow;
+  borrow = a.limb[1] < borrow;
+  r.limb[1] = t - b.limb[1];
+  borrow += t < b.limb[1];
+
+  t = a.limb[2] - borrow;
+  borrow = a.limb[2] < borrow;
+  r.limb[2] = t - b.limb[2];
+  borrow += t < b.limb[2];
+
+  r.limb[3] = a.limb[3] - b.limb[3] - borrow;
+  return r;
+}
+
+TYPES_API TYPES_INLINE u128 u128_shl(u128 a, int n)
+{
+  u128 r = {{0, 0, 0, 0}};
+  int words;
+  int bits;
+  int i;
+
+  if (n <= 0)
+  {
+    return a;
+  }
+  if (n >= 128)
+  {
+    return r;
+  }
+
+  words = n >> 5;
+  bits = n & 31;
+
+  for (i = 3; i >= words; --i)
+  {
+    r.limb[i] = a.limb[i - words] << bits;
+    if (bits && i - words > 0)
+    {
+      r.limb[i] |= a.limb[i - words - 1] >> (32 - bits);
+    }
+  }
+  return r;
+}
+
+TYPES_API TYPES_INLINE u128 u128_shr(u128 a, int n)
+{
+  u128 r = {{0, 0, 0, 0}};
+  int words;
+  int bits;
+  int i;
+
+  if (n <= 0)
+  {
+    return a;
+  }
+  if (n >= 128)
+  {
+    return r;
+  }
+
+  words = n >> 5;
+  bits = n & 31;
+
+  for (i = 0; i + words <= 3; ++i)
+  {
+    r.limb[i] = a.limb[i + words] >> bits;
+    if (bits && i + words < 3)
+    {
+      r.limb[i] |= a.limb[i + words + 1] << (32 - bits);
+    }
+  }
+  return r;
+}
+
+/* ---- Signed Math ---- */
+TYPES_API TYPES_INLINE i128 i128_add(i128 a, i128 b)
+{
+  return i128_from_u128(u128_add(u128_from_i128(a), u128_from_i128(b)));
+}
+
+TYPES_API TYPES_INLINE i128 i128_sub(i128 a, i128 b)
+{
+  return i128_from_u128(u128_sub(u128_from_i128(a), u128_from_i128(b)));
+}
+
+TYPES_API TYPES_INLINE i128 i128_neg(i128 a)
+{
+  u128 zero = {{0, 0, 0, 0}};
+  return i128_from_u128(u128_sub(zero, u128_from_i128(a)));
+}
+
+TYPES_API TYPES_INLINE i128 i128_shl(i128 a, int n)
+{
+  return i128_from_u128(u128_shl(u128_from_i128(a), n));
+}
+
+TYPES_API TYPES_INLINE i128 i128_shr(i128 a, int n)
+{
+  u32 sign = 0U - (a.limb[3] >> 31);
+  i128 r;
+
+  if (n >= 128)
+  {
+    r.limb[0] = sign;
+    r.limb[1] = sign;
+    r.limb[2] = sign;
+    r.limb[3] = sign;
+    return r;
+  }
+
+  /* Arithmetic shift: shift the complement of negative values logically */
+  r = i128_from_u128(u128_shr(u128_from_i128(a), n));
+  if (sign && n > 0)
+  {
+    u128 fill = {{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}};
+    u128 mask = u128_shl(fill, 128 - n);
+    r.limb[0] |= mask.limb[0];
+    r.limb[1] |= mask.limb[1];
+    r.limb[2] |= mask.limb[2];
+    r.limb[3] |= mask.limb[3];
+  }
+  return r;
+}
+
+/* ---- Comparisons ---- */
+TYPES_API TYPES_INLINE int u128_eq(u128 a, u128 b)
+{
+  return a.limb[0] == b.limb[0] && a.limb[1] == b.limb[1] &&
+         a.limb[2] == b.limb[2] && a.limb[3] == b.limb[3];
+}
+
+TYPES_API TYPES_INLINE int u128_lt(u128 a, u128 b)
+{
+  int i;
+  for (i = 3; i >= 0; --i)
+  {
+    if (a.limb[i] != b.limb[i])
+    {
+      return a.limb[i] < b.limb[i];
+    }
+  }
+  return 0;
+}
+
+TYPES_API TYPES_INLINE int u128_le(u128 a, u128 b)
+{
+  return !u128_lt(b, a);
+}
+
+TYPES_API TYPES_INLINE int i128_eq(i128 a, i128 b)
+{
+  return u128_eq(u128_from_i128(a), u128_from_i128(b));
+}
+
+TYPES_API TYPES_INLINE int i128_lt(i128 a, i128 b)
+{
+  /* Flipping the sign bits maps the signed order onto the unsigned one */
+  u128 ua = u128_from_i128(a);
+  u128 ub = u128_from_i128(b);
+  ua.limb[3] ^= 0x80000000;
+  ub.limb[3] ^= 0x80000000;
+  return u128_lt(ua, ub);
+}
+
+TYPES_API TYPES_INLINE int i128_le(i128 a, i128 b)
+{
+  return !i128_lt(b, a);
+}
+
+/* ---- Widening Multiplication ---- */
+TYPES_API TYPES_INLINE u128 u64_mul_wide(u64 a, u64 b)
+{
+  u128 r;
+  u32 a0 = u64_low(a), a1 = u64_high(a);
+  u32 b0 = u64_low(b), b1 = u64_high(b);
+  u32 h00, h01, h10, h11;
+  u32 l01, l10, l11;
+  u32 carry;
+  u32 t;
+
+  r.limb[0] = types_u32_mul_wide(a0, b0, &h00);
+  l01 = types_u32_mul_wide(a0, b1, &h01);
+  l10 = types_u32_mul_wide(a1, b0, &h10);
+  l11 = types_u32_mul_wide(a1, b1, &h11);
+
+  /* Column 1: h00 + l01 + l10 */
+  t = h00 + l01;
+  carry = t < l01;
+  r.limb[1] = t + l10;
+  carry += r.limb[1] < l10;
+
+  /* Column 2: h01 + h10 + l11 + carry, h11 absorbs the carry out */
+  t = h01 + carry;
+  carry = t < carry;
+  t += h10;
+  carry += t < h10;
+  r.limb[2] = t + l11;
+  carry += r.limb[2] < l11;
+
+  r.limb[3] = h11 + carry;
+  return r;
+}
+
+TYPES_API TYPES_INLINE i128 i64_mul_wide(i64 a, i64 b)
+{
+  /* Signed product from the unsigned one: subtract b << 64 if a < 0 and a << 64 if b < 0 */
+  u64 ua = u64_from_i64(a);
+  u64 ub = u64_from_i64(b);
+  u128 r = u64_mul_wide(ua, ub);
+
+  if (u64_high(ua) >> 31)
+  {
+    r = u128_sub(r, u128_shl(u128_from_u64(ub), 64));
+  }
+  if (u64_high(ub) >> 31)
+  {
+    r = u128_sub(r, u128_shl(u128_from_u64(ua), 64));
+  }
+  return i128_from_u128(r);
+}
+
+#endif /* TYPES_NATIVE128 */
+
+/* ---- Shared 128-bit Helpers ---- */
+TYPES_API TYPES_INLINE int u128_ne(u128 a, u128 b)
+{
+  return !u128_eq(a, b);
+}
+
+TYPES_API TYPES_INLINE int u128_gt(u128 a, u128 b)
+{
+  return u128_lt(b, a);
+}
+
+TYPES_API TYPES_INLINE int u128_ge(u128 a, u128 b)
+{
+  return u128_le(b, a);
+}
+
+TYPES_API TYPES_INLINE int i128_ne(i128 a, i128 b)
+{
+  return !i128_eq(a, b);
+}
+
+TYPES_API TYPES_INLINE int i128_gt(i128 a, i128 b)
+{
+  return i128_lt(b, a);
+}
+
+TYPES_API TYPES_INLINE int i128_ge(i128 a, i128 b)
+{
+  return i128_le(b, a);
+}
+
+/* Upper 64 bits of the full 64x64 bit product, e.g. for (hash * n) >> 64 range reduction */
+TYPES_API TYPES_INLINE u64 u64_mulhi(u64 a, u64 b)
+{
+  return u128_high(u64_mul_wide(a, b));
+}
+
+TYPES_API TYPES_INLINE i64 i64_mulhi(i64 a, i64 b)
+{
+  return i64_from_u64(u128_high(u128_from_i128(i64_mul_wide(a, b))));
+}
+
+/* #############################################################################
+ * # Checked and Saturating Arithmetic
+ * #############################################################################
+ *
+ * *_overflow stores the wrapped result in *r and returns true if the exact
+ * result did not fit. *_sat clamps to the min/max of the type instead. The
+ * saturating versions select the result with masks and do not branch.
+ *
+ * 8 and 16 bit values are computed exactly in 32 bits. 32 bit values use
+ * __builtin_*_overflow when available, and so do 64-bit values in native
+ * mode. The emulated 64-bit code derives the flags from the limb carries.
+ */
+/* ---- Unsigned 8/16-bit ---- */
+TYPES_API TYPES_INLINE b32 u8_add_overflow(u8 a, u8 b, u8 *r)
+{
+  u32 s = (u32)a + b;
+  *r = (u8)s;
+  return s > U8_MAX;
+}
+
+TYPES_API TYPES_INLINE b32 u8_sub_overflow(u8 a, u8 b, u8 *r)
+{
+  *r = (u8)(a - b);
+  return a < b;
+}
+
+TYPES_API TYPES_INLINE b32 u8_mul_overflow(u8 a, u8 b, u8 *r)
+{
+  u32 p = (u32)a * b;
+  *r = (u8)p;
+  return p > U8_MAX;
+}
+
+TYPES_API TYPES_INLINE b32 u16_add_overflow(u16 a, u16 b, u16 *r)
+{
+  u32 s = (u32)a + b;
+  *r = (u16)s;
+  return s > U16_MAX;
+}
+
+TYPES_API TYPES_INLINE b32 u16_sub_overflow(u16 a, u16 b, u16 *r)
+{
+  *r = (u16)(a - b);
+  return a < b;
+}
+
+TYPES_API TYPES_INLINE b32 u16_mul_overflow(u16 a, u16 b, u16 *r)
+{
+  u32 p = (u32)a * b;
+  *r = (u16)p;
+  return p > U16_MAX;
+}
+
+TYPES_API TYPES_INLINE u8 u8_add_sat(u8 a, u8 b)
+{
+  u8 r;
+  b32 o = u8_add_overflow(a, b, &r);
+  return (u8)(r | (0U - (u32)o));
+}
+
+TYPES_API TYPES_INLINE u8 u8_sub_sat(u8 a, u8 b)
+{
+  u8 r;
+  b32 o = u8_sub_overflow(a, b, &r);
+  return (u8)(r & ((u32)o - 1U));
+}
+
+TYPES_API TYPES_INLINE u8 u8_mul_sat(u8 a, u8 b)
+{
+  u8 r;
+  b32 o = u8_mul_overflow(a, b, &r);
+  return (u8)(r | (0U - (u32)o));
+}
+
+TYPES_API TYPES_INLINE u16 u16_add_sat(u16 a, u16 b)
+{
+  u16 r;
+  b32 o = u16_add_overflow(a, b, &r);
+  return (u16)(r | (0U - (u32)o));
+}
+
+TYPES_API TYPES_INLINE u16 u16_sub_sat(u16 a, u16 b)
+{
+  u16 r;
+  b32 o = u16_sub_overflow(a, b, &r);
+  return (u16)(r & ((u32)o - 1U));
+}
+
+TYPES_API TYPES_INLINE u16 u16_mul_sat(u16 a, u16 b)
+{
+  u16 r;
+  b32 o = u16_mul_overflow(a, b, &r);
+  return (u16)(r | (0U - (u32)o));
+}
+
+/* ---- Signed 8/16-bit ---- */
+TYPES_API TYPES_INLINE b32 i8_add_overflow(i8 a, i8 b, i8 *r)
+{
+  i32 s = (i32)a + b;
+  *r = (i8)s;
+  return (s < I8_MIN) | (s > I8_MAX);
+}
+
+TYPES_API TYPES_INLINE b32 i8_sub_overflow(i8 a, i8 b, i8 *r)
+{
+  i32 d = (i32)a - b;
+  *r = (i8)d;
+  return (d < I8_MIN) | (d > I8_MAX);
+}
+
+TYPES_API TYPES_INLINE b32 i8_mul_overflow(i8 a, i8 b, i8 *r)
+{
+  i32 p = (i32)a * b;
+  *r = (i8)p;
+  return (p < I8_MIN) | (p > I8_MAX);
+}
+
+TYPES_API TYPES_INLINE b32 i16_add_overflow(i16 a, i16 b, i16 *r)
+{
+  i32 s = (i32)a + b;
+  *r = (i16)s;
+  return (s < I16_MIN) | (s > I16_MAX);
+}
+
+TYPES_API TYPES_INLINE b32 i16_sub_overflow(i16 a, i16 b, i16 *r)
+{
+  i32 d = (i32)a - b;
+  *r = (i16)d;
+  return (d < I16_MIN) | (d > I16_MAX);
+}
+
+TYPES_API TYPES_INLINE b32 i16_mul_overflow(i16 a, i16 b, i16 *r)
+{
+  i32 p = (i32)a * b;
+  *r = (i16)p;
+  return (p < I16_MIN) | (p > I16_MAX);
+}
+
+/* The saturated value is MAX for a non-negative sign bit and MIN otherwise */
+TYPES_API TYPES_INLINE i8 i8_add_sat(i8 a, i8 b)
+{
+  i8 r;
+  u32 m = 0U - (u32)i8_add_overflow(a, b, &r);
+  u32 sat = ((u32)(u8)a >> 7) + (u32)I8_MAX;
+  return (i8)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE i8 i8_sub_sat(i8 a, i8 b)
+{
+  i8 r;
+  u32 m = 0U - (u32)i8_sub_overflow(a, b, &r);
+  u32 sat = ((u32)(u8)a >> 7) + (u32)I8_MAX;
+  return (i8)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE i8 i8_mul_sat(i8 a, i8 b)
+{
+  i8 r;
+  u32 m = 0U - (u32)i8_mul_overflow(a, b, &r);
+  u32 sat = ((u32)(u8)(a ^ b) >> 7) + (u32)I8_MAX;
+  return (i8)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE i16 i16_add_sat(i16 a, i16 b)
+{
+  i16 r;
+  u32 m = 0U - (u32)i16_add_overflow(a, b, &r);
+  u32 sat = ((u32)(u16)a >> 15) + (u32)I16_MAX;
+  return (i16)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE i16 i16_sub_sat(i16 a, i16 b)
+{
+  i16 r;
+  u32 m = 0U - (u32)i16_sub_overflow(a, b, &r);
+  u32 sat = ((u32)(u16)a >> 15) + (u32)I16_MAX;
+  return (i16)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE i16 i16_mul_sat(i16 a, i16 b)
+{
+  i16 r;
+  u32 m = 0U - (u32)i16_mul_overflow(a, b, &r);
+  u32 sat = ((u32)(u16)(a ^ b) >> 15) + (u32)I16_MAX;
+  return (i16)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+/* ---- Unsigned 32-bit ---- */
+TYPES_API TYPES_INLINE b32 u32_add_overflow(u32 a, u32 b, u32 *r)
+{
+#ifdef TYPES_HAS_BUILTIN_OVERFLOW
+  return __builtin_add_overflow(a, b, r);
+#else
+  *r = a + b;
+  return *r < a;
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 u32_sub_overflow(u32 a, u32 b, u32 *r)
+{
+#ifdef TYPES_HAS_BUILTIN_OVERFLOW
+  return __builtin_sub_overflow(a, b, r);
+#else
+  *r = a - b;
+  return a < b;
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 u32_mul_overflow(u32 a, u32 b, u32 *r)
+{
+#ifdef TYPES_HAS_BUILTIN_OVERFLOW
+  return __builtin_mul_overflow(a, b, r);
+#else
+  u32 high;
+  *r = types_u32_mul_wide(a, b, &high);
+  return high != 0;
+#endif
+}
+
+TYPES_API TYPES_INLINE u32 u32_add_sat(u32 a, u32 b)
+{
+  u32 r;
+  b32 o = u32_add_overflow(a, b, &r);
+  return r | (0U - (u32)o);
+}
+
+TYPES_API TYPES_INLINE u32 u32_sub_sat(u32 a, u32 b)
+{
+  u32 r;
+  b32 o = u32_sub_overflow(a, b, &r);
+  return r & ((u32)o - 1U);
+}
+
+TYPES_API TYPES_INLINE u32 u32_mul_sat(u32 a, u32 b)
+{
+  u32 r;
+  b32 o = u32_mul_overflow(a, b, &r);
+  return r | (0U - (u32)o);
+}
+
+/* ---- Signed 32-bit ---- */
+TYPES_API TYPES_INLINE b32 i32_add_overflow(i32 a, i32 b, i32 *r)
+{
+#ifdef TYPES_HAS_BUILTIN_OVERFLOW
+  return __builtin_add_overflow(a, b, r);
+#else
+  /* Overflow if the result sign differs from both operand signs */
+  u32 s = (u32)a + (u32)b;
+  *r = (i32)s;
+  return (b32)((((u32)a ^ s) & ((u32)b ^ s)) >> 31);
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 i32_sub_overflow(i32 a, i32 b, i32 *r)
+{
+#ifdef TYPES_HAS_BUILTIN_OVERFLOW
+  return __builtin_sub_overflow(a, b, r);
+#else
+  /* Overflow if the operand signs differ and the result sign differs from a */
+  u32 d = (u32)a - (u32)b;
+  *r = (i32)d;
+  return (b32)((((u32)a ^ (u32)b) & ((u32)a ^ d)) >> 31);
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 i32_mul_overflow(i32 a, i32 b, i32 *r)
+{
+#ifdef TYPES_HAS_BUILTIN_OVERFLOW
+  return __builtin_mul_overflow(a, b, r);
+#else
+  /* The 64-bit product fits if the high word is the sign extension of the low word */
+  i64 p = i64_mul(i64_from_i32(a), i64_from_i32(b));
+  *r = (i32)i64_low(p);
+  return i64_high(p) != (i32)(0U - (i64_low(p) >> 31));
+#endif
+}
+
+TYPES_API TYPES_INLINE i32 i32_add_sat(i32 a, i32 b)
+{
+  i32 r;
+  u32 m = 0U - (u32)i32_add_overflow(a, b, &r);
+  u32 sat = ((u32)a >> 31) + (u32)I32_MAX;
+  return (i32)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE i32 i32_sub_sat(i32 a, i32 b)
+{
+  i32 r;
+  u32 m = 0U - (u32)i32_sub_overflow(a, b, &r);
+  u32 sat = ((u32)a >> 31) + (u32)I32_MAX;
+  return (i32)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE i32 i32_mul_sat(i32 a, i32 b)
+{
+  i32 r;
+  u32 m = 0U - (u32)i32_mul_overflow(a, b, &r);
+  u32 sat = (((u32)a ^ (u32)b) >> 31) + (u32)I32_MAX;
+  return (i32)((u32)r ^ (((u32)r ^ sat) & m));
+}
+
+/* ---- Unsigned 64-bit ---- */
+TYPES_API TYPES_INLINE b32 u64_add_overflow(u64 a, u64 b, u64 *r)
+{
+#if defined(TYPES_NATIVE64) && defined(TYPES_HAS_BUILTIN_OVERFLOW)
+  return __builtin_add_overflow(a, b, r);
+#elif defined(TYPES_NATIVE64)
+  *r = a + b;
+  return *r < a;
+#else
+  /* Carry out of the high word, either from the word sum or the low carry */
+  u32 low = a.low + b.low;
+  u32 carry = (u32)(low < a.low);
+  u32 high = a.high + b.high;
+  b32 o = (high < a.high) | (high + carry < high);
+  r->low = low;
+  r->high = high + carry;
+  return o;
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 u64_sub_overflow(u64 a, u64 b, u64 *r)
+{
+#if defined(TYPES_NATIVE64) && defined(TYPES_HAS_BUILTIN_OVERFLOW)
+  return __builtin_sub_overflow(a, b, r);
+#elif defined(TYPES_NATIVE64)
+  *r = a - b;
+  return a < b;
+#else
+  u32 borrow = (u32)(a.low < b.low);
+  b32 o = (a.high < b.high) | ((a.high == b.high) & (int)borrow);
+  r->low = a.low - b.low;
+  r->high = a.high - b.high - borrow;
+  return o;
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 u64_mul_overflow(u64 a, u64 b, u64 *r)
+{
+#if defined(TYPES_NATIVE64) && defined(TYPES_HAS_BUILTIN_OVERFLOW)
+  return __builtin_mul_overflow(a, b, r);
+#elif defined(TYPES_NATIVE64)
+  *r = a * b;
+  return u64_mulhi(a, b) != 0;
+#else
+  /* (ah * 2^32 + al) * (bh * 2^32 + bl) fits only if ah or bh is zero and
+   * the cross products plus the high word of al * bl stay below 2^32.
+   */
+  u32 low_high;
+  u32 cross1_high;
+  u32 cross2_high;
+  u32 low = types_u32_mul_wide(a.low, b.low, &low_high);
+  u32 cross1 = types_u32_mul_wide(a.high, b.low, &cross1_high);
+  u32 cross2 = types_u32_mul_wide(a.low, b.high, &cross2_high);
+  u32 cross = cross1 + cross2;
+  u32 high = low_high + cross;
+  r->low = low;
+  r->high = high;
+  return ((a.high != 0) & (b.high != 0)) | (cross1_high != 0) | (cross2_high != 0) | (cross < cross1) | (high < cross);
+#endif
+}
+
+TYPES_API TYPES_INLINE u64 u64_add_sat(u64 a, u64 b)
+{
+  u64 r;
+  u32 m = 0U - (u32)u64_add_overflow(a, b, &r);
+  return u64_or(r, u64_make(m, m));
+}
+
+TYPES_API TYPES_INLINE u64 u64_sub_sat(u64 a, u64 b)
+{
+  u64 r;
+  u32 m = (u32)u64_sub_overflow(a, b, &r) - 1U;
+  return u64_and(r, u64_make(m, m));
+}
+
+TYPES_API TYPES_INLINE u64 u64_mul_sat(u64 a, u64 b)
+{
+  u64 r;
+  u32 m = 0U - (u32)u64_mul_overflow(a, b, &r);
+  return u64_or(r, u64_make(m, m));
+}
+
+/* ---- Signed 64-bit ---- */
+TYPES_API TYPES_INLINE b32 i64_add_overflow(i64 a, i64 b, i64 *r)
+{
+#if defined(TYPES_NATIVE64) && defined(TYPES_HAS_BUILTIN_OVERFLOW)
+  return __builtin_add_overflow(a, b, r);
+#else
+  u64 s = u64_add(u64_from_i64(a), u64_from_i64(b));
+  u32 high = u64_high(s);
+  *r = i64_from_u64(s);
+  return (b32)((((u32)i64_high(a) ^ high) & ((u32)i64_high(b) ^ high)) >> 31);
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 i64_sub_overflow(i64 a, i64 b, i64 *r)
+{
+#if defined(TYPES_NATIVE64) && defined(TYPES_HAS_BUILTIN_OVERFLOW)
+  return __builtin_sub_overflow(a, b, r);
+#else
+  u64 d = u64_sub(u64_from_i64(a), u64_from_i64(b));
+  u32 high = u64_high(d);
+  *r = i64_from_u64(d);
+  return (b32)((((u32)i64_high(a) ^ (u32)i64_high(b)) & ((u32)i64_high(a) ^ high)) >> 31);
+#endif
+}
+
+TYPES_API TYPES_INLINE b32 i64_mul_overflow(i64 a, i64 b, i64 *r)
+{
+#if defined(TYPES_NATIVE64) && defined(TYPES_HAS_BUILTIN_OVERFLOW)
+  return __builtin_mul_overflow(a, b, r);
+#else
+  /* Multiply the magnitudes, a negative product may reach 2^63 */
+  u32 sign_a = 0U - ((u32)i64_high(a) >> 31);
+  u32 sign_b = 0U - ((u32)i64_high(b) >> 31);
+  u64 mask_a = u64_make(sign_a, sign_a);
+  u64 mask_b = u64_make(sign_b, sign_b);
+  u64 abs_a = u64_sub(u64_xor(u64_from_i64(a), mask_a), mask_a);
+  u64 abs_b = u64_sub(u64_xor(u64_from_i64(b), mask_b), mask_b);
+  u64 limit = u64_add_u32(u64_make((u32)I32_MAX, U32_MAX), (sign_a ^ sign_b) & 1U);
+  u64 p;
+  b32 o = u64_mul_overflow(abs_a, abs_b, &p);
+  *r = i64_mul(a, b);
+  return o | u64_lt(limit, p);
+#endif
+}
+
+TYPES_API TYPES_INLINE i64 i64_add_sat(i64 a, i64 b)
+{
+  i64 r;
+  u32 m = 0U - (u32)i64_add_overflow(a, b, &r);
+  u64 sat = u64_add_u32(u64_make((u32)I32_MAX, U32_MAX), (u32)i64_high(a) >> 31);
+  u64 bits = u64_from_i64(r);
+  return i64_from_u64(u64_xor(bits, u64_and(u64_xor(bits, sat), u64_make(m, m))));
+}
+
+TYPES_API TYPES_INLINE i64 i64_sub_sat(i64 a, i64 b)
+{
+  i64 r;
+  u32 m = 0U - (u32)i64_sub_overflow(a, b, &r);
+  u64 sat = u64_add_u32(u64_make((u32)I32_MAX, U32_MAX), (u32)i64_high(a) >> 31);
+  u64 bits = u64_from_i64(r);
+  return i64_from_u64(u64_xor(bits, u64_and(u64_xor(bits, sat), u64_make(m, m))));
+}
+
+TYPES_API TYPES_INLINE i64 i64_mul_sat(i64 a, i64 b)
+{
+  i64 r;
+  u32 m = 0U - (u32)i64_mul_overflow(a, b, &r);
+  u64 sat = u64_add_u32(u64_make((u32)I32_MAX, U32_MAX), ((u32)i64_high(a) ^ (u32)i64_high(b)) >> 31);
+  u64 bits = u64_from_i64(r);
+  return i64_from_u64(u64_xor(bits, u64_and(u64_xor(bits, sat), u64_make(m, m))));
+}
+
+/* #############################################################################
+ * # Fixed Point Numbers (Q16.16 and Q32.32)
+ * #############################################################################
+ *
+ * q16_16 is an i32 with 16 fractional bits, q32_32 an i64 with 32 fractional
+ * bits. Only integer operations are used, the f32 conversions are meant for
+ * setup and debugging on targets without an FPU.
+ *
+ * mul and the integer conversions round towards negative infinity, the
+ * _round versions to nearest (ties up). div truncates towards zero and
+ * saturates on overflow and on division by zero. For loops dividing by the
+ * same value compute the reciprocal once and multiply with it.
+ */
+typedef i32 q16_16;
+typedef i64 q32_32;
+
+#define Q16_16_ONE 65536
+#define Q16_16_MAX I32_MAX
+#define Q16_16_MIN I32_MIN
+
+/* Full signed 32x32->64 bit product. Returns the low word. */
+TYPES_API TYPES_INLINE u32 types_i32_mul_wide(i32 a, i32 b, i32 *high)
+{
+  u32 h;
+  u32 low = types_u32_mul_wide((u32)a, (u32)b, &h);
+  /* Signed correction of the unsigned high word */
+  h -= ((u32)b & (0U - ((u32)a >> 31))) + ((u32)a & (0U - ((u32)b >> 31)));
+  *high = (i32)h;
+  return low;
+}
+
+/* ---- Q16.16 Conversions ---- */
+TYPES_API TYPES_INLINE q16_16 q16_16_from_i32(i32 x)
+{
+  return (q16_16)((u32)x << 16);
+}
+
+TYPES_API TYPES_INLINE i32 q16_16_to_i32(q16_16 a)
+{
+  return a >> 16;
+}
+
+TYPES_API TYPES_INLINE i32 q16_16_to_i32_round(q16_16 a)
+{
+  return (a >> 16) + ((a >> 15) & 1);
+}
+
+/* Rounds to nearest and saturates */
+TYPES_API TYPES_INLINE q16_16 q16_16_from_f32(f32 x)
+{
+  f32 s = x * 65536.0f;
+  if (s >= 2147483648.0f)
+  {
+    return Q16_16_MAX;
+  }
+  if (s <= -2147483648.0f)
+  {
+    return Q16_16_MIN;
+  }
+  return (q16_16)(s + ((s < 0.0f) ? -0.5f : 0.5f));
+}
+
+TYPES_API TYPES_INLINE f32 q16_16_to_f32(q16_16 a)
+{
+  return (f32)a * (1.0f / 65536.0f);
+}
+
+/* ---- Q16.16 Math ---- */
+TYPES_API TYPES_INLINE q16_16 q16_16_add(q16_16 a, q16_16 b)
+{
+  return (q16_16)((u32)a + (u32)b);
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_sub(q16_16 a, q16_16 b)
+{
+  return (q16_16)((u32)a - (u32)b);
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_add_sat(q16_16 a, q16_16 b)
+{
+  return i32_add_sat(a, b);
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_sub_sat(q16_16 a, q16_16 b)
+{
+  return i32_sub_sat(a, b);
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_mul(q16_16 a, q16_16 b)
+{
+  i32 high;
+  u32 low = types_i32_mul_wide(a, b, &high);
+  return (q16_16)(((u32)high << 16) | (low >> 16));
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_mul_round(q16_16 a, q16_16 b)
+{
+  i32 high;
+  u32 low = types_i32_mul_wide(a, b, &high);
+  u32 rounded = low + 0x8000U;
+  u32 h = (u32)high + (u32)(rounded < low);
+  return (q16_16)((h << 16) | (rounded >> 16));
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_mul_sat(q16_16 a, q16_16 b)
+{
+  i32 high;
+  u32 low = types_i32_mul_wide(a, b, &high);
+  u32 r = ((u32)high << 16) | (low >> 16);
+  /* The shifted product fits if high is in [-0x8000, 0x7FFF] */
+  u32 m = 0U - (u32)(((u32)high + 0x8000U) > 0xFFFFU);
+  u32 sat = ((u32)high >> 31) + (u32)I32_MAX;
+  return (q16_16)(r ^ ((r ^ sat) & m));
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_div(q16_16 a, q16_16 b)
+{
+  u32 neg = ((u32)a ^ (u32)b) >> 31;
+  u32 abs_a = ((u32)a >> 31) ? 0U - (u32)a : (u32)a;
+  u32 abs_b = ((u32)b >> 31) ? 0U - (u32)b : (u32)b;
+  u64 q;
+
+  if (abs_b == 0)
+  {
+    return (a < 0) ? Q16_16_MIN : Q16_16_MAX;
+  }
+
+  q = u64_div_u32(u64_make(abs_a >> 16, abs_a << 16), abs_b);
+  if (u64_high(q) != 0 || u64_low(q) > (u32)I32_MAX + neg)
+  {
+    return neg ? Q16_16_MIN : Q16_16_MAX;
+  }
+  return (q16_16)(neg ? 0U - u64_low(q) : u64_low(q));
+}
+
+TYPES_API TYPES_INLINE q16_16 q16_16_recip(q16_16 a)
+{
+  return q16_16_div(Q16_16_ONE, a);
+}
+
+/* ---- Q32.32 Conversions ---- */
+TYPES_API TYPES_INLINE q32_32 q32_32_from_i32(i32 x)
+{
+  return i64_make(x, 0);
+}
+
+TYPES_API TYPES_INLINE i32 q32_32_to_i32(q32_32 a)
+{
+  return i64_high(a);
+}
+
+TYPES_API TYPES_INLINE i32 q32_32_to_i32_round(q32_32 a)
+{
+  return (i32)((u32)i64_high(a) + (i64_low(a) >> 31));
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_from_q16_16(q16_16 a)
+{
+  return i64_make(a >> 16, (u32)a << 16);
+}
+
+TYPES_API TYPES_INLINE q16_16 q32_32_to_q16_16(q32_32 a)
+{
+  return (q16_16)(((u32)i64_high(a) << 16) | (i64_low(a) >> 16));
+}
+
+/* Integer and fractional part are converted separately, |x| must be below 2^31 */
+TYPES_API TYPES_INLINE q32_32 q32_32_from_f32(f32 x)
+{
+  i32 whole = (i32)x;
+  f32 frac;
+  if ((f32)whole > x)
+  {
+    whole -= 1;
+  }
+  frac = (x - (f32)whole) * 4294967296.0f;
+  return i64_make(whole, (frac >= 4294967295.0f) ? U32_MAX : (u32)frac);
+}
+
+TYPES_API TYPES_INLINE f32 q32_32_to_f32(q32_32 a)
+{
+  return (f32)i64_high(a) + (f32)i64_low(a) * (1.0f / 4294967296.0f);
+}
+
+/* ---- Q32.32 Math ---- */
+TYPES_API TYPES_INLINE q32_32 q32_32_add(q32_32 a, q32_32 b)
+{
+  return i64_add(a, b);
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_sub(q32_32 a, q32_32 b)
+{
+  return i64_sub(a, b);
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_add_sat(q32_32 a, q32_32 b)
+{
+  return i64_add_sat(a, b);
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_sub_sat(q32_32 a, q32_32 b)
+{
+  return i64_sub_sat(a, b);
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_mul(q32_32 a, q32_32 b)
+{
+  return i64_from_u64(u128_low(u128_from_i128(i128_shr(i64_mul_wide(a, b), 32))));
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_mul_round(q32_32 a, q32_32 b)
+{
+  i128 p = i128_add(i64_mul_wide(a, b), i128_from_i64(i64_make(0, 0x80000000)));
+  return i64_from_u64(u128_low(u128_from_i128(i128_shr(p, 32))));
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_mul_sat(q32_32 a, q32_32 b)
+{
+  i128 p = i64_mul_wide(a, b);
+  /* The shifted product fits if bits 95..127 are all equal */
+  i128 top = i128_shr(p, 95);
+  u32 m = 0U - (u32)(!i128_eq(top, i128_from_i64(i64_make(0, 0))) & !i128_eq(top, i128_from_i64(i64_make(-1, 0xFFFFFFFF))));
+  u64 r = u128_low(u128_from_i128(i128_shr(p, 32)));
+  u64 sat = u64_add_u32(u64_make((u32)I32_MAX, U32_MAX), (u32)i128_lt(p, i128_from_i64(i64_make(0, 0))));
+  return i64_from_u64(u64_xor(r, u64_and(u64_xor(r, sat), u64_make(m, m))));
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_div(q32_32 a, q32_32 b)
+{
+  u32 sign_a = 0U - ((u32)i64_high(a) >> 31);
+  u32 sign_b = 0U - ((u32)i64_high(b) >> 31);
+  u32 neg = (sign_a ^ sign_b) & 1U;
+  u64 abs_a = u64_sub(u64_xor(u64_from_i64(a), u64_make(sign_a, sign_a)), u64_make(sign_a, sign_a));
+  u64 abs_b = u64_sub(u64_xor(u64_from_i64(b), u64_make(sign_b, sign_b)), u64_make(sign_b, sign_b));
+  u64 whole;
+  u64 r;
+  u64 q;
+  u32 frac = 0;
+
+  if (u64_eq(abs_b, u64_make(0, 0)))
+  {
+    return sign_a ? i64_make(I32_MIN, 0) : i64_make(I32_MAX, U32_MAX);
+  }
+
+  whole = u64_divmod(abs_a, abs_b, &r);
+  if (u64_high(whole) != 0 || u64_low(whole) > 0x80000000U)
+  {
+    return neg ? i64_make(I32_MIN, 0) : i64_make(I32_MAX, U32_MAX);
+  }
+
+  if (u64_high(abs_b) == 0)
+  {
+    /* r < 2^32 so the fraction is a single 64/32 bit division */
+    frac = u64_low(u64_div_u32(u64_make(u64_low(r), 0), u64_low(abs_b)));
+  }
+  else
+  {
+    /* Restoring division for the 32 fractional bits, r < abs_b < 2^64 */
+    int i;
+    for (i = 0; i < 32; ++i)
+    {
+      u32 top = u64_high(r) >> 31;
+      r = u64_shl(r, 1);
+      frac <<= 1;
+      if (top || u64_ge(r, abs_b))
+      {
+        r = u64_sub(r, abs_b);
+        frac |= 1;
+      }
+    }
+  }
+
+  q = u64_make(u64_low(whole), frac);
+  if (u64_lt(u64_add_u32(u64_make((u32)I32_MAX, U32_MAX), neg), q))
+  {
+    return neg ? i64_make(I32_MIN, 0) : i64_make(I32_MAX, U32_MAX);
+  }
+  return i64_from_u64(neg ? u64_sub(u64_make(0, 0), q) : q);
+}
+
+TYPES_API TYPES_INLINE q32_32 q32_32_recip(q32_32 a)
+{
+  return q32_32_div(q32_32_from_i32(1), a);
+}
+
+/* #############################################################################
+ * # Invariant Integer Division
+ * #############################################################################
+ *
+ * Precomputes a magic multiplier for a divisor that is reused many times
+ * (Granlund-Montgomery round-up method). Dividing then costs one high
+ * multiply, an add, a subtract and two shifts for every divisor >= 1.
+ *
+ *   u32_divider d = u32_divider_make(page_size);
+ *   u32 page = u32_divider_div(&d, offset);
+ */
+typedef struct u32_divider
+{
+  u32 magic;
+  u32 divisor;
+  int shift1;
+  int shift2;
+} u32_divider;
+
+typedef struct u64_divider
+{
+  u64 magic;
+  u64 divisor;
+  int shift1;
+  int shift2;
+} u64_divider;
+
+/* The divisor must not be zero. */
+TYPES_API TYPES_INLINE u32_divider u32_divider_make(u32 divisor)
+{
+  u32_divider d;
+  u32 remainder;
+  int l = (divisor > 1) ? 32 - u32_clz(divisor - 1) : 0;
+
+  /* magic = floor(2^32 * (2^l - divisor) / divisor) + 1 */
+  u32 high = ((l == 32) ? 0U : (1U << l)) - divisor;
+  d.magic = types_u32_divlu(high, 0, divisor, &remainder) + 1;
+  d.divisor = divisor;
+  d.shift1 = (l > 0) ? 1 : 0;
+  d.shift2 = (l > 0) ? l - 1 : 0;
+  return d;
+}
+
+TYPES_API TYPES_INLINE u32 u32_divider_div(const u32_divider *d, u32 n)
+{
+  u32 t;
+  types_u32_mul_wide(d->magic, n, &t);
+  return (t + ((n - t) >> d->shift1)) >> d->shift2;
+}
+
+TYPES_API TYPES_INLINE u32 u32_divider_mod(const u32_divider *d, u32 n)
+{
+  return n - u32_divider_div(d, n) * d->divisor;
+}
+
+/* The divisor must not be zero. */
+TYPES_API TYPES_INLINE u64_divider u64_divider_make(u64 divisor)
+{
+  u64_divider d;
+  u32 high = u64_high(divisor);
+  u32 low = u64_low(divisor);
+  u128 remainder;
+  u128 quotient = u128_from_u64(u64_make(0, 0));
+  u128 one = u128_from_u64(u64_make(0, 1));
+  int l;
+  int i;
+
+  /* l = ceil(log2(divisor)) from the leading zeros of divisor - 1 */
+  if (high == 0 && low <= 1)
+  {
+    l = 0;
+  }
+  else
+  {
+    high -= (low == 0);
+    low -= 1;
+    l = high ? 64 - u32_clz(high) : 32 - u32_clz(low);
+  }
+
+  /* magic = floor(2^64 * (2^l - divisor) / divisor) + 1. The quotient is
+   * below 2^64 so a one-off shift-subtract loop over 64 bits suffices.
+   */
+  remainder = u128_shl(u128_sub(u128_shl(one, l), u128_from_u64(divisor)), 64);
+  for (i = 63; i >= 0; --i)
+  {
+    u128 shifted = u128_shl(u128_from_u64(divisor), i);
+    if (u128_le(shifted, remainder))
+    {
+      remainder = u128_sub(remainder, shifted);
+      quotient = u128_add(quotient, u128_shl(one, i));
+    }
+  }
+
+  d.magic = u128_low(u128_add(quotient, one));
+  d.divisor = divisor;
+  d.shift1 = (l > 0) ? 1 : 0;
+  d.shift2 = (l > 0) ? l - 1 : 0;
+  return d;
+}
+
+TYPES_API TYPES_INLINE u64 u64_divider_div(const u64_divider *d, u64 n)
+{
+  u64 t = u64_mulhi(d->magic, n);
+  return u64_shr(u64_add(t, u64_shr(u64_sub(n, t), d->shift1)), d->shift2);
+}
+
+TYPES_API TYPES_INLINE u64 u64_divider_mod(const u64_divider *d, u64 n)
+{
+  return u64_sub(n, u64_mul(u64_divider_div(d, n), d->divisor));
+}
+
+/* #############################################################################
+ * # Hashing
+ * #############################################################################
+ *
+ * Non-cryptographic 64-bit hashes, e.g. for hash tables and sharding. They are
+ * defined on u64/u128 operations only, so native and emulated builds produce
+ * the same values. On 32-bit targets the 64x64->128 multiply runs as four
+ * u32 partial products (see u64_mul_wide).
+ *
+ * u64_hash_bytes follows the wyhash construction and reads its input as
+ * little-endian on every platform. The finalizers map integer keys directly.
+ */
+/* Folds the 128-bit product: low ^ high */
+TYPES_API TYPES_INLINE u64 types_hash_mix(u64 a, u64 b)
+{
+  u128 p = u64_mul_wide(a, b);
+  return u64_xor(u128_low(p), u128_high(p));
+}
+
+TYPES_API TYPES_INLINE u64 u64_hash_bytes(const void *data, u32 length, u64 seed)
+{
+  const u8 *p = (const u8 *)data;
+  u64 secret0 = u64_make(0x2D358DCC, 0xAA6C78A5);
+  u64 secret1 = u64_make(0x8BB84B93, 0x962EACC9);
+  u64 secret2 = u64_make(0x4B33A62E, 0xD433D4A3);
+  u64 secret3 = u64_make(0x4D5A2DA5, 0x1DE1AA47);
+  u64 a;
+  u64 b;
+  u128 m;
+
+  seed = u64_xor(seed, types_hash_mix(u64_xor(seed, secret0), secret1));
+
+  if (length <= 16)
+  {
+    if (length >= 4)
+    {
+      /* Two possibly overlapping 4-byte reads from each end */
+      u32 offset = (length >> 3) << 2;
+      a = u64_make(u32_load_le(p), u32_load_le(p + offset));
+      b = u64_make(u32_load_le(p + length - 4), u32_load_le(p + length - 4 - offset));
+    }
+    else if (length > 0)
+    {
+      a = u64_make(0, ((u32)p[0] << 16) | ((u32)p[length >> 1] << 8) | p[length - 1]);
+      b = u64_make(0, 0);
+    }
+    else
+    {
+      a = u64_make(0, 0);
+      b = a;
+    }
+  }
+  else
+  {
+    u32 i = length;
+    if (i >= 48)
+    {
+      /* Three independent lanes */
+      u64 see1 = seed;
+      u64 see2 = seed;
+      do
+      {
+        seed = types_hash_mix(u64_xor(u64_load_le(p), secret1), u64_xor(u64_load_le(p + 8), seed));
+        see1 = types_hash_mix(u64_xor(u64_load_le(p + 16), secret2), u64_xor(u64_load_le(p + 24), see1));
+        see2 = types_hash_mix(u64_xor(u64_load_le(p + 32), secret3), u64_xor(u64_load_le(p + 40), see2));
+        p += 48;
+        i -= 48;
+      } while (i >= 48);
+      seed = u64_xor(seed, u64_xor(see1, see2));
+    }
+    while (i > 16)
+    {
+      seed = types_hash_mix(u64_xor(u64_load_le(p), secret1), u64_xor(u64_load_le(p + 8), seed));
+      p += 16;
+      i -= 16;
+    }
+    /* The last 16 bytes, overlapping already hashed ones */
+    a = u64_load_le(p + i - 16);
+    b = u64_load_le(p + i - 8);
+  }
+
+  m = u64_mul_wide(u64_xor(a, secret1), u64_xor(b, seed));
+  a = u128_low(m);
+  b = u128_high(m);
+  return types_hash_mix(u64_xor(u64_xor(a, secret0), u64_make(0, length)), u64_xor(b, secret1));
+}
+
+/* SplitMix64 finalizer (Stafford variant 13) */
+TYPES_API TYPES_INLINE u64 u64_hash_splitmix(u64 x)
+{
+  x = u64_mul(u64_xor(x, u64_shr(x, 30)), u64_make(0xBF58476D, 0x1CE4E5B9));
+  x = u64_mul(u64_xor(x, u64_shr(x, 27)), u64_make(0x94D049BB, 0x133111EB));
+  return u64_xor(x, u64_shr(x, 31));
+}
+
+/* MurmurHash3 fmix64 */
+TYPES_API TYPES_INLINE u64 u64_hash_murmur(u64 x)
+{
+  x = u64_mul(u64_xor(x, u64_shr(x, 33)), u64_make(0xFF51AFD7, 0xED558CCD));
+  x = u64_mul(u64_xor(x, u64_shr(x, 33)), u64_make(0xC4CEB9FE, 0x1A85EC53));
+  return u64_xor(x, u64_shr(x, 33));
+}
+
+/* MurmurHash3 fmix32 */
+TYPES_API TYPES_INLINE u32 u32_hash_murmur(u32 x)
+{
+  x = (x ^ (x >> 16)) * 0x85EBCA6B;
+  x = (x ^ (x >> 13)) * 0xC2B2AE35;
+  return x ^ (x >> 16);
+}
+
+/* #############################################################################
+ * # Random Number Generators
+ * #############################################################################
+ *
+ * Non-cryptographic generators that produce the same sequences in native and
+ * emulated mode.
+ *
+ *   rng_splitmix64  64-bit state, mainly used to seed the others
+ *   rng_xoshiro256  xoshiro256**, 256-bit state, jump functions that skip
+ *                   2^128 or 2^192 outputs for non-overlapping streams
+ *   rng_pcg32       PCG-XSH-RR with 32-bit output, selectable stream and
+ *                   arbitrary advance
+ *
+ * The bounded functions use Lemire's multiply-shift method. A division is
+ * only needed on the rare rejection path. The float functions return values
+ * in [0, 1).
+ *
+ *   rng_xoshiro256 rng = rng_xoshiro256_make(u64_make(0, 42));
+ *   u64 die = rng_xoshiro256_bounded(&rng, u64_make(0, 6));
+ */
+typedef struct rng_splitmix64
+{
+  u64 state;
+} rng_splitmix64;
+
+typedef struct rng_xoshiro256
+{
+  u64 s[4];
+} rng_xoshiro256;
+
+typedef struct rng_pcg32
+{
+  u64 state;
+  u64 inc;
+} rng_pcg32;
+
+/* ---- Float Conversion ---- */
+/* Uses the upper 24 bits */
+TYPES_API TYPES_INLINE f32 rng_f32_from_u32(u32 x)
+{
+  return (f32)(x >> 8) * (1.0f / 16777216.0f);
+}
+
+/* Uses the upper 53 bits */
+TYPES_API TYPES_INLINE f64 rng_f64_from_u64(u64 x)
+{
+  u32 high = u64_high(x);
+  u32 low = u64_low(x);
+  return ((f64)(high >> 11) * 4294967296.0 + (f64)((high << 21) | (low >> 11))) * (1.0 / 9007199254740992.0);
+}
+
+/* ---- SplitMix64 ---- */
+TYPES_API TYPES_INLINE rng_splitmix64 rng_splitmix64_make(u64 seed)
+{
+  rng_splitmix64 r;
+  r.state = seed;
+  return r;
+}
+
+TYPES_API TYPES_INLINE u64 rng_splitmix64_next(rng_splitmix64 *r)
+{
+  r->state = u64_add(r->state, u64_make(0x9E3779B9, 0x7F4A7C15));
+  return u64_hash_splitmix(r->state);
+}
+
+/* ---- xoshiro256** ---- */
+/* The state is expanded from the seed with SplitMix64, so it is never all zero */
+TYPES_API TYPES_INLINE rng_xoshiro256 rng_xoshiro256_make(u64 seed)
+{
+  rng_xoshiro256 r;
+  rng_splitmix64 sm = rng_splitmix64_make(seed);
+  r.s[0] = rng_splitmix64_next(&sm);
+  r.s[1] = rng_splitmix64_next(&sm);
+  r.s[2] = rng_splitmix64_next(&sm);
+  r.s[3] = rng_splitmix64_next(&sm);
+  return r;
+}
+
+TYPES_API TYPES_INLINE u64 rng_xoshiro256_next(rng_xoshiro256 *r)
+{
+  u64 s0 = r->s[0];
+  u64 s1 = r->s[1];
+  u64 s2 = r->s[2];
+  u64 s3 = r->s[3];
+  /* rotl(s1 * 5, 7) * 9 with the constant multiplies as shift-adds */
+  u64 x = u64_rotl(u64_add(s1, u64_shl(s1, 2)), 7);
+  u64 result = u64_add(x, u64_shl(x, 3));
+  u64 t = u64_shl(s1, 17);
+
+  s2 = u64_xor(s2, s0);
+  s3 = u64_xor(s3, s1);
+  s1 = u64_xor(s1, s2);
+  s0 = u64_xor(s0, s3);
+  s2 = u64_xor(s2, t);
+  s3 = u64_rotl(s3, 45);
+
+  r->s[0] = s0;
+  r->s[1] = s1;
+  r->s[2] = s2;
+  r->s[3] = s3;
+  return result;
+}
+
+TYPES_API TYPES_INLINE void types_xoshiro256_jump(rng_xoshiro256 *r, const u32 *polynomial)
+{
+  u64 s0 = u64_make(0, 0);
+  u64 s1 = s0;
+  u64 s2 = s0;
+  u64 s3 = s0;
+  int i;
+  int b;
+
+  /* polynomial holds four u64 as (high, low) u32 pairs */
+  for (i = 0; i < 8; ++i)
+  {
+    u32 word = polynomial[i ^ 1];
+    for (b = 0; b < 32; ++b)
+    {
+      if (word & BIT(b))
+      {
+        s0 = u64_xor(s0, r->s[0]);
+        s1 = u64_xor(s1, r->s[1]);
+        s2 = u64_xor(s2, r->s[2]);
+        s3 = u64_xor(s3, r->s[3]);
+      }
+      rng_xoshiro256_next(r);
+    }
+  }
+
+  r->s[0] = s0;
+  r->s[1] = s1;
+  r->s[2] = s2;
+  r->s[3] = s3;
+}
+
+/* Equivalent to 2^128 calls of next, gives 2^128 non-overlapping streams */
+TYPES_API TYPES_INLINE void rng_xoshiro256_jump(rng_xoshiro256 *r)
+{
+  static const u32 polynomial[8] = {
+      0x180EC6D3, 0x3CFD0ABA, 0xD5A61266, 0xF0C9392C,
+      0xA9582618, 0xE03FC9AA, 0x39ABDC45, 0x29B1661C};
+  types_xoshiro256_jump(r, polynomial);
+}
+
+/* Equivalent to 2^192 calls of next, e.g. one long_jump per machine and jump per thread */
+TYPES_API TYPES_INLINE void rng_xoshiro256_long_jump(rng_xoshiro256 *r)
+{
+  static const u32 polynomial[8] = {
+      0x76E15D3E, 0xFEFDCBBF, 0xC5004E44, 0x1C522FB3,
+      0x77710069, 0x854EE241, 0x39109BB0, 0x2ACBE635};
+  types_xoshiro256_jump(r, polynomial);
+}
+
+TYPES_API TYPES_INLINE void rng_xoshiro256_fill_u64(rng_xoshiro256 *r, u64 *out, u32 count)
+{
+  /* Keeps the state in locals for the whole loop */
+  rng_xoshiro256 local = *r;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    out[i] = rng_xoshiro256_next(&local);
+  }
+  *r = local;
+}
+
+/* Both halves of every output are used */
+TYPES_API TYPES_INLINE void rng_xoshiro256_fill_u32(rng_xoshiro256 *r, u32 *out, u32 count)
+{
+  rng_xoshiro256 local = *r;
+  u32 i;
+  for (i = 0; i + 1 < count; i += 2)
+  {
+    u64 x = rng_xoshiro256_next(&local);
+    out[i] = u64_high(x);
+    out[i + 1] = u64_low(x);
+  }
+  if (i < count)
+  {
+    out[i] = u64_high(rng_xoshiro256_next(&local));
+  }
+  *r = local;
+}
+
+/* Uniform in [0, range), range must not be zero */
+TYPES_API TYPES_INLINE u64 rng_xoshiro256_bounded(rng_xoshiro256 *r, u64 range)
+{
+  u128 m = u64_mul_wide(rng_xoshiro256_next(r), range);
+  if (u64_lt(u128_low(m), range))
+  {
+    /* Reject the 2^64 mod range lowest values of the low word */
+    u64 threshold = u64_mod(u64_sub(u64_make(0, 0), range), range);
+    while (u64_lt(u128_low(m), threshold))
+    {
+      m = u64_mul_wide(rng_xoshiro256_next(r), range);
+    }
+  }
+  return u128_high(m);
+}
+
+TYPES_API TYPES_INLINE f32 rng_xoshiro256_f32(rng_xoshiro256 *r)
+{
+  return rng_f32_from_u32(u64_high(rng_xoshiro256_next(r)));
+}
+
+TYPES_API TYPES_INLINE f64 rng_xoshiro256_f64(rng_xoshiro256 *r)
+{
+  return rng_f64_from_u64(rng_xoshiro256_next(r));
+}
+
+/* ---- PCG32 ---- */
+TYPES_API TYPES_INLINE u32 rng_pcg32_next(rng_pcg32 *r)
+{
+  u64 old = r->state;
+  u32 xorshifted;
+  r->state = u64_add(u64_mul(old, u64_make(0x5851F42D, 0x4C957F2D)), r->inc);
+  xorshifted = u64_low(u64_shr(u64_xor(u64_shr(old, 18), old), 27));
+  return u32_rotr(xorshifted, (int)(u64_high(old) >> 27));
+}
+
+/* Generators with a different stream never share a sequence */
+TYPES_API TYPES_INLINE rng_pcg32 rng_pcg32_make(u64 seed, u64 stream)
+{
+  rng_pcg32 r;
+  r.state = u64_make(0, 0);
+  r.inc = u64_or(u64_shl(stream, 1), u64_make(0, 1));
+  rng_pcg32_next(&r);
+  r.state = u64_add(r.state, seed);
+  rng_pcg32_next(&r);
+  return r;
+}
+
+/* Skips delta outputs in O(log delta) steps (Brown, "Random Number Generation with Arbitrary Strides") */
+TYPES_API TYPES_INLINE void rng_pcg32_advance(rng_pcg32 *r, u64 delta)
+{
+  u64 cur_mult = u64_make(0x5851F42D, 0x4C957F2D);
+  u64 cur_plus = r->inc;
+  u64 acc_mult = u64_make(0, 1);
+  u64 acc_plus = u64_make(0, 0);
+
+  while (!u64_eq(delta, u64_make(0, 0)))
+  {
+    if (u64_low(delta) & 1)
+    {
+      acc_mult = u64_mul(acc_mult, cur_mult);
+      acc_plus = u64_add(u64_mul(acc_plus, cur_mult), cur_plus);
+    }
+    cur_plus = u64_mul(u64_add(cur_mult, u64_make(0, 1)), cur_plus);
+    cur_mult = u64_mul(cur_mult, cur_mult);
+    delta = u64_shr(delta, 1);
+  }
+  r->state = u64_add(u64_mul(acc_mult, r->state), acc_plus);
+}
+
+TYPES_API TYPES_INLINE void rng_pcg32_fill_u32(rng_pcg32 *r, u32 *out, u32 count)
+{
+  rng_pcg32 local = *r;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    out[i] = rng_pcg32_next(&local);
+  }
+  *r = local;
+}
+
+/* Two outputs per value, the first one is the high word */
+TYPES_API TYPES_INLINE void rng_pcg32_fill_u64(rng_pcg32 *r, u64 *out, u32 count)
+{
+  rng_pcg32 local = *r;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    u32 high = rng_pcg32_next(&local);
+    out[i] = u64_make(high, rng_pcg32_next(&local));
+  }
+  *r = local;
+}
+
+/* Uniform in [0, range), range must not be zero */
+TYPES_API TYPES_INLINE u32 rng_pcg32_bounded(rng_pcg32 *r, u32 range)
+{
+  u32 high;
+  u32 low = types_u32_mul_wide(rng_pcg32_next(r), range, &high);
+  if (low < range)
+  {
+    u32 threshold = (0U - range) % range;
+    while (low < threshold)
+    {
+      low = types_u32_mul_wide(rng_pcg32_next(r), range, &high);
+    }
+  }
+  return high;
+}
+
+TYPES_API TYPES_INLINE f32 rng_pcg32_f32(rng_pcg32 *r)
+{
+  return rng_f32_from_u32(rng_pcg32_next(r));
+}
+
+/* #############################################################################
+ * # Bitset
+ * #############################################################################
+ *
+ * Fixed size bitset over caller provided u32 words (no allocation). Bits past
+ * count in the last word are kept zero. Searches, counts and range updates
+ * work on whole words.
+ *
+ * Only u32 storage is supported, there is no u64 word variant: the emulated
+ * u64 is a pair of u32 words, so the C89 loops would not get any wider.
+ *
+ *   u32 storage[BITSET_WORDS(1024)];
+ *   bitset free_slots = bitset_make(storage, 1024);
+ *   u32 i;
+ *
+ *   bitset_set_range(&free_slots, 0, 1024);
+ *   for (i = bitset_find_set(&free_slots, 0); i < free_slots.count; i = bitset_find_set(&free_slots, i + 1))
+ *   {
+ *   }
+ */
+#define BITSET_WORDS(bits) (((bits) + 31) / 32)
+
+typedef struct bitset
+{
+  u32 *words;
+  u32 count; /* Number of bits */
+} bitset;
+
+/* Clears the storage, which must hold BITSET_WORDS(count) words */
+TYPES_API TYPES_INLINE bitset bitset_make(u32 *words, u32 count)
+{
+  bitset s;
+  u32 i;
+  s.words = words;
+  s.count = count;
+  for (i = 0; i < BITSET_WORDS(count); ++i)
+  {
+    words[i] = 0;
+  }
+  return s;
+}
+
+TYPES_API TYPES_INLINE void bitset_set(bitset *s, u32 i)
+{
+  BIT_SET(s->words[i >> 5], i & 31);
+}
+
+TYPES_API TYPES_INLINE void bitset_clear(bitset *s, u32 i)
+{
+  BIT_CLEAR(s->words[i >> 5], i & 31);
+}
+
+TYPES_API TYPES_INLINE void bitset_toggle(bitset *s, u32 i)
+{
+  BIT_TOGGLE(s->words[i >> 5], i & 31);
+}
+
+TYPES_API TYPES_INLINE int bitset_test(const bitset *s, u32 i)
+{
+  return BIT_CHECK(s->words[i >> 5], i & 31);
+}
+
+/* Sets the bits [start, start + n) */
+TYPES_API TYPES_INLINE void bitset_set_range(bitset *s, u32 start, u32 n)
+{
+  u32 end = start + n;
+  u32 first;
+  u32 last;
+  u32 head;
+  u32 tail;
+  u32 w;
+
+  if (n == 0)
+  {
+    return;
+  }
+
+  first = start >> 5;
+  last = (end - 1) >> 5;
+  head = U32_MAX << (start & 31);
+  tail = U32_MAX >> (31 - ((end - 1) & 31));
+
+  if (first == last)
+  {
+    s->words[first] |= head & tail;
+    return;
+  }
+
+  s->words[first] |= head;
+  for (w = first + 1; w < last; ++w)
+  {
+    s->words[w] = U32_MAX;
+  }
+  s->words[last] |= tail;
+}
+
+/* Clears the bits [start, start + n) */
+TYPES_API TYPES_INLINE void bitset_clear_range(bitset *s, u32 start, u32 n)
+{
+  u32 end = start + n;
+  u32 first;
+  u32 last;
+  u32 head;
+  u32 tail;
+  u32 w;
+
+  if (n == 0)
+  {
+    return;
+  }
+
+  first = start >> 5;
+  last = (end - 1) >> 5;
+  head = U32_MAX << (start & 31);
+  tail = U32_MAX >> (31 - ((end - 1) & 31));
+
+  if (first == last)
+  {
+    s->words[first] &= ~(head & tail);
+    return;
+  }
+
+  s->words[first] &= ~head;
+  for (w = first + 1; w < last; ++w)
+  {
+    s->words[w] = 0;
+  }
+  s->words[last] &= ~tail;
+}
+
+/* Number of set bits */
+TYPES_API TYPES_INLINE u32 bitset_popcount(const bitset *s)
+{
+  u32 total = 0;
+  u32 i;
+  for (i = 0; i < BITSET_WORDS(s->count); ++i)
+  {
+    total += (u32)u32_popcount(s->words[i]);
+  }
+  return total;
+}
+
+/* Index of the first set bit >= from, or count if there is none */
+TYPES_API TYPES_INLINE u32 bitset_find_set(const bitset *s, u32 from)
+{
+  u32 words = BITSET_WORDS(s->count);
+  u32 w = from >> 5;
+  u32 bits;
+
+  if (from >= s->count)
+  {
+    return s->count;
+  }
+
+  /* Mask off the bits below from in the first word */
+  bits = s->words[w] & (U32_MAX << (from & 31));
+  while (bits == 0)
+  {
+    if (++w == words)
+    {
+      return s->count;
+    }
+    bits = s->words[w];
+  }
+  return (w << 5) + (u32)u32_ctz(bits);
+}
+
+/* Index of the first clear bit >= from, or count if there is none */
+TYPES_API TYPES_INLINE u32 bitset_find_clear(const bitset *s, u32 from)
+{
+  u32 words = BITSET_WORDS(s->count);
+  u32 w = from >> 5;
+  u32 bits;
+  u32 i;
+
+  if (from >= s->count)
+  {
+    return s->count;
+  }
+
+  bits = ~s->words[w] & (U32_MAX << (from & 31));
+  while (bits == 0)
+  {
+    if (++w == words)
+    {
+      return s->count;
+    }
+    bits = ~s->words[w];
+  }
+
+  /* The zero padding past count reads as clear */
+  i = (w << 5) + (u32)u32_ctz(bits);
+  return (i < s->count) ? i : s->count;
+}
+
+/* ---- Bulk Operations (all bitsets have the same count, r may alias a or b) ---- */
+TYPES_API TYPES_INLINE void bitset_and(bitset *r, const bitset *a, const bitset *b)
+{
+  u32 i;
+  for (i = 0; i < BITSET_WORDS(r->count); ++i)
+  {
+    r->words[i] = a->words[i] & b->words[i];
+  }
+}
+
+TYPES_API TYPES_INLINE void bitset_or(bitset *r, const bitset *a, const bitset *b)
+{
+  u32 i;
+  for (i = 0; i < BITSET_WORDS(r->count); ++i)
+  {
+    r->words[i] = a->words[i] | b->words[i];
+  }
+}
+
+/* r = a & ~b, e.g. slots free in a but not reserved in b */
+TYPES_API TYPES_INLINE void bitset_andnot(bitset *r, const bitset *a, const bitset *b)
+{
+  u32 i;
+  for (i = 0; i < BITSET_WORDS(r->count); ++i)
+  {
+    r->words[i] = a->words[i] & ~b->words[i];
+  }
+}
+
+/* #############################################################################
+ * # Arena Allocator
+ * #############################################################################
+ *
+ * Linear (bump) allocator over a caller provided buffer. Allocating costs an
+ * align and a bounds check, memory is released all at once with
+ * arena_reset or back to a marker taken with arena_save.
+ *
+ *   static u8 memory[1 << 16];
+ *   arena a = arena_make(memory, sizeof(memory));
+ *   arena_marker scratch = arena_save(&a);
+ *   u32 *ids = ARENA_PUSH_ARRAY(&a, u32, 128);
+ *   arena_restore(&a, scratch);
+ *
+ * Define TYPES_ARENA_STATS to track the highest offset ever used (see
+ * arena_high_water), e.g. to size the buffers.
+ */
+/* Alignment requirement of a type: struct { char c; type t; } pads c up to it */
+#define TYPES_ALIGNOF(type) ((u32)(sizeof(struct { char c; type t; }) - sizeof(type)))
+
+#define ARENA_PUSH_ARRAY(a, type, count) ((type *)arena_push_array((a), (u32)sizeof(type), (count), TYPES_ALIGNOF(type)))
+#define ARENA_PUSH_STRUCT(a, type) ARENA_PUSH_ARRAY(a, type, 1)
+#define ARENA_PUSH_ARRAY_ZERO(a, type, count) ((type *)arena_push_array_zero((a), (u32)sizeof(type), (count), TYPES_ALIGNOF(type)))
+
+/* Unsigned integer wide enough for a pointer, only the low bits are used to align */
+#if defined(__UINTPTR_TYPE__)
+__extension__ typedef __UINTPTR_TYPE__ types_uptr;
+#elif defined(_WIN64)
+typedef unsigned __int64 types_uptr;
+#else
+typedef unsigned long types_uptr;
+#endif
+
+typedef struct arena
+{
+  u8 *base;
+  u32 capacity;
+  u32 offset;
+#ifdef TYPES_ARENA_STATS
+  u32 high_water;
+#endif
+} arena;
+
+typedef u32 arena_marker;
+
+TYPES_API TYPES_INLINE arena arena_make(void *buffer, u32 capacity)
+{
+  arena a;
+  a.base = (u8 *)buffer;
+  a.capacity = capacity;
+  a.offset = 0;
+#ifdef TYPES_ARENA_STATS
+  a.high_water = 0;
+#endif
+  return a;
+}
+
+/* Returns size bytes aligned to align (a power of two), or 0 if the arena is full.
+ * The memory is not cleared.
+ */
+TYPES_API TYPES_INLINE void *arena_push(arena *a, u32 size, u32 align)
+{
+  u32 padding = (0U - (u32)(types_uptr)(a->base + a->offset)) & (align - 1);
+  u32 remaining = a->capacity - a->offset;
+  u8 *result;
+
+  if (padding > remaining || size > remaining - padding)
+  {
+    return (void *)0;
+  }
+
+  result = a->base + a->offset + padding;
+  a->offset += padding + size;
+#ifdef TYPES_ARENA_STATS
+  if (a->offset > a->high_water)
+  {
+    a->high_water = a->offset;
+  }
+#endif
+  return result;
+}
+
+TYPES_API TYPES_INLINE void *arena_push_zero(arena *a, u32 size, u32 align)
+{
+  u8 *result = (u8 *)arena_push(a, size, align);
+  u32 i;
+  if (result)
+  {
+    for (i = 0; i < size; ++i)
+    {
+      result[i] = 0;
+    }
+  }
+  return result;
+}
+
+/* count elements of size bytes, or 0 if they do not fit (or size is 0). The
+ * count is checked against the space left before multiplying, so size * count
+ * cannot wrap into a small allocation.
+ */
+TYPES_API TYPES_INLINE void *arena_push_array(arena *a, u32 size, u32 count, u32 align)
+{
+  if (size == 0 || count > (a->capacity - a->offset) / size)
+  {
+    return (void *)0;
+  }
+  return arena_push(a, size * count, align);
+}
+
+TYPES_API TYPES_INLINE void *arena_push_array_zero(arena *a, u32 size, u32 count, u32 align)
+{
+  if (size == 0 || count > (a->capacity - a->offset) / size)
+  {
+    return (void *)0;
+  }
+  return arena_push_zero(a, size * count, align);
+}
+
+TYPES_API TYPES_INLINE arena_marker arena_save(const arena *a)
+{
+  return a->offset;
+}
+
+/* Frees everything pushed after the marker was taken */
+TYPES_API TYPES_INLINE void arena_restore(arena *a, arena_marker marker)
+{
+  a->offset = marker;
+}
+
+TYPES_API TYPES_INLINE void arena_reset(arena *a)
+{
+  a->offset = 0;
+}
+
+TYPES_API TYPES_INLINE u32 arena_remaining(const arena *a)
+{
+  return a->capacity - a->offset;
+}
+
+#ifdef TYPES_ARENA_STATS
+TYPES_API TYPES_INLINE u32 arena_high_water(const arena *a)
+{
+  return a->high_water;
+}
+#endif
+
+/* #############################################################################
+ * # Memory
+ * #############################################################################
+ *
+ * nostdlib replacements for memcpy, memmove, memset, memcmp and memchr. The
+ * unaligned head and the tail are handled bytewise, the main loop moves a
+ * pointer sized word (or a 16 byte register with TYPES_SIMD) at a time.
+ *
+ * TYPES_MEMCPY and TYPES_MEMSET forward constant sizes up to 64 bytes to the
+ * GCC/clang builtins in optimized builds, which expand them into a few moves
+ * instead of calling a library function. TYPES_MEMMOVE and TYPES_MEMCMP always
+ * call types_memmove/types_memcmp: GCC does not expand those builtins for most
+ * sizes and emits a memmove/memcmp call even with -ffreestanding.
+ *
+ * Note that GCC and clang may still turn byte loops into memcpy/memset calls,
+ * build nostdlib programs with -ffreestanding or -fno-builtin.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__OPTIMIZE__)
+#define TYPES_MEMCPY(dst, src, size) (__builtin_constant_p(size) && (size) <= 64 ? __builtin_memcpy((dst), (src), (size)) : types_memcpy((dst), (src), (u32)(size)))
+#define TYPES_MEMSET(dst, value, size) (__builtin_constant_p(size) && (size) <= 64 ? __builtin_memset((dst), (value), (size)) : types_memset((dst), (u8)(value), (u32)(size)))
+#else
+#define TYPES_MEMCPY(dst, src, size) types_memcpy((dst), (src), (u32)(size))
+#define TYPES_MEMSET(dst, value, size) types_memset((dst), (u8)(value), (u32)(size))
+#endif
+#define TYPES_MEMMOVE(dst, src, size) types_memmove((dst), (src), (u32)(size))
+#define TYPES_MEMCMP(a, b, size) types_memcmp((a), (b), (u32)(size))
+
+/* may_alias: a word may read and write bytes of any type */
+#if defined(__GNUC__) || defined(__clang__)
+typedef types_uptr __attribute__((__may_alias__)) types_word;
+typedef types_uptr __attribute__((__may_alias__, __aligned__(1))) types_word_unaligned;
+#else
+typedef types_uptr types_word;
+typedef types_uptr types_word_unaligned;
+#endif
+
+#define TYPES_WORD_SIZE ((u32)sizeof(types_uptr))
+#define TYPES_WORD_ALIGNED(p) (((types_uptr)(p) & (TYPES_WORD_SIZE - 1)) == 0)
+
+/* Targets where a misaligned word load costs about the same as an aligned
+ * one. Elsewhere the word loops only run if both pointers share the alignment.
+ */
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) || defined(__aarch64__) || defined(_M_ARM64)
+#define TYPES_MEM_UNALIGNED
+#endif
+
+#if defined(TYPES_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TYPES_MEM_SSE2
+#include <emmintrin.h>
+#elif defined(TYPES_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define TYPES_MEM_NEON
+#include <arm_neon.h>
+#endif
+
+/* The copy and set loops align their stores to this, a misaligned store
+ * that splits a cache line costs more than the bytewise head.
+ */
+#if defined(TYPES_MEM_SSE2) || defined(TYPES_MEM_NEON)
+#define TYPES_MEM_ALIGN 16U
+#else
+#define TYPES_MEM_ALIGN TYPES_WORD_SIZE
+#endif
+#define TYPES_MEM_ALIGNED(p) (((types_uptr)(p) & (TYPES_MEM_ALIGN - 1)) == 0)
+
+TYPES_API TYPES_INLINE b32 types_mem_words(const void *a, const void *b)
+{
+#ifdef TYPES_MEM_UNALIGNED
+  (void)a;
+  (void)b;
+  return 1;
+#else
+  return TYPES_WORD_ALIGNED((types_uptr)a ^ (types_uptr)b);
+#endif
+}
+
+TYPES_API TYPES_INLINE void types_mem_copy_forward(u8 *d, const u8 *s, u32 size)
+{
+  if (size >= 2 * TYPES_MEM_ALIGN)
+  {
+    /* Align the stores, a load may still be misaligned */
+    while (!TYPES_MEM_ALIGNED(d))
+    {
+      *d++ = *s++;
+      --size;
+    }
+
+#if defined(TYPES_MEM_SSE2)
+    for (; size >= 32; size -= 32, d += 32, s += 32)
+    {
+      __m128i r0 = _mm_loadu_si128((const __m128i *)(const void *)s);
+      __m128i r1 = _mm_loadu_si128((const __m128i *)(const void *)(s + 16));
+      _mm_store_si128((__m128i *)(void *)d, r0);
+      _mm_store_si128((__m128i *)(void *)(d + 16), r1);
+    }
+#elif defined(TYPES_MEM_NEON)
+    for (; size >= 32; size -= 32, d += 32, s += 32)
+    {
+      uint8x16_t r0 = vld1q_u8(s);
+      uint8x16_t r1 = vld1q_u8(s + 16);
+      vst1q_u8(d, r0);
+      vst1q_u8(d + 16, r1);
+    }
+#endif
+
+    if (types_mem_words(d, s))
+    {
+      /* Four independent words per iteration keep the load ports busy */
+      for (; size >= 4 * TYPES_WORD_SIZE; size -= 4 * TYPES_WORD_SIZE, d += 4 * TYPES_WORD_SIZE, s += 4 * TYPES_WORD_SIZE)
+      {
+        types_uptr w0 = ((const types_word_unaligned *)(const void *)s)[0];
+        types_uptr w1 = ((const types_word_unaligned *)(const void *)s)[1];
+        types_uptr w2 = ((const types_word_unaligned *)(const void *)s)[2];
+        types_uptr w3 = ((const types_word_unaligned *)(const void *)s)[3];
+        ((types_word *)(void *)d)[0] = w0;
+        ((types_word *)(void *)d)[1] = w1;
+        ((types_word *)(void *)d)[2] = w2;
+        ((types_word *)(void *)d)[3] = w3;
+      }
+      for (; size >= TYPES_WORD_SIZE; size -= TYPES_WORD_SIZE, d += TYPES_WORD_SIZE, s += TYPES_WORD_SIZE)
+      {
+        *(types_word *)(void *)d = *(const types_word_unaligned *)(const void *)s;
+      }
+    }
+  }
+
+  while (size--)
+  {
+    *d++ = *s++;
+  }
+}
+
+/* Copies from the end, for a destination overlapping the end of the source */
+TYPES_API TYPES_INLINE void types_mem_copy_backward(u8 *d, const u8 *s, u32 size)
+{
+  d += size;
+  s += size;
+
+  if (size >= 2 * TYPES_MEM_ALIGN)
+  {
+    while (!TYPES_MEM_ALIGNED(d))
+    {
+      *--d = *--s;
+      --size;
+    }
+
+#if defined(TYPES_MEM_SSE2)
+    for (; size >= 32; size -= 32)
+    {
+      __m128i r0;
+      __m128i r1;
+      d -= 32;
+      s -= 32;
+      r0 = _mm_loadu_si128((const __m128i *)(const void *)s);
+      r1 = _mm_loadu_si128((const __m128i *)(const void *)(s + 16));
+      _mm_store_si128((__m128i *)(void *)d, r0);
+      _mm_store_si128((__m128i *)(void *)(d + 16), r1);
+    }
+#elif defined(TYPES_MEM_NEON)
+    for (; size >= 32; size -= 32)
+    {
+      uint8x16_t r0;
+      uint8x16_t r1;
+      d -= 32;
+      s -= 32;
+      r0 = vld1q_u8(s);
+      r1 = vld1q_u8(s + 16);
+      vst1q_u8(d, r0);
+      vst1q_u8(d + 16, r1);
+    }
+#endif
+
+    if (types_mem_words(d, s))
+    {
+      for (; size >= 4 * TYPES_WORD_SIZE; size -= 4 * TYPES_WORD_SIZE)
+      {
+        types_uptr w0;
+        types_uptr w1;
+        types_uptr w2;
+        types_uptr w3;
+        d -= 4 * TYPES_WORD_SIZE;
+        s -= 4 * TYPES_WORD_SIZE;
+        w0 = ((const types_word_unaligned *)(const void *)s)[0];
+        w1 = ((const types_word_unaligned *)(const void *)s)[1];
+        w2 = ((const types_word_unaligned *)(const void *)s)[2];
+        w3 = ((const types_word_unaligned *)(const void *)s)[3];
+        ((types_word *)(void *)d)[0] = w0;
+        ((types_word *)(void *)d)[1] = w1;
+        ((types_word *)(void *)d)[2] = w2;
+        ((types_word *)(void *)d)[3] = w3;
+      }
+      for (; size >= TYPES_WORD_SIZE; size -= TYPES_WORD_SIZE)
+      {
+        d -= TYPES_WORD_SIZE;
+        s -= TYPES_WORD_SIZE;
+        *(types_word *)(void *)d = *(const types_word_unaligned *)(const void *)s;
+      }
+    }
+  }
+
+  while (size--)
+  {
+    *--d = *--s;
+  }
+}
+
+TYPES_API TYPES_INLINE void *types_memcpy(void *TYPES_RESTRICT dst, const void *TYPES_RESTRICT src, u32 size)
+{
+  types_mem_copy_forward((u8 *)dst, (const u8 *)src, size);
+  return dst;
+}
+
+TYPES_API TYPES_INLINE void *types_memmove(void *dst, const void *src, u32 size)
+{
+  /* Unsigned distance: only dst in [src, src + size) needs the backward copy */
+  if ((types_uptr)dst - (types_uptr)src >= (types_uptr)size)
+  {
+    types_mem_copy_forward((u8 *)dst, (const u8 *)src, size);
+  }
+  else
+  {
+    types_mem_copy_backward((u8 *)dst, (const u8 *)src, size);
+  }
+  return dst;
+}
+
+TYPES_API TYPES_INLINE void *types_memset(void *dst, u8 value, u32 size)
+{
+  u8 *d = (u8 *)dst;
+
+  if (size >= 2 * TYPES_MEM_ALIGN)
+  {
+    types_uptr word = ((types_uptr)-1 / 0xFF) * (types_uptr)value;
+
+    while (!TYPES_MEM_ALIGNED(d))
+    {
+      *d++ = value;
+      --size;
+    }
+
+#if defined(TYPES_MEM_SSE2)
+    {
+      __m128i v = _mm_set1_epi8((char)value);
+      for (; size >= 32; size -= 32, d += 32)
+      {
+        _mm_store_si128((__m128i *)(void *)d, v);
+        _mm_store_si128((__m128i *)(void *)(d + 16), v);
+      }
+    }
+#elif defined(TYPES_MEM_NEON)
+    {
+      uint8x16_t v = vdupq_n_u8(value);
+      for (; size >= 32; size -= 32, d += 32)
+      {
+        vst1q_u8(d, v);
+        vst1q_u8(d + 16, v);
+      }
+    }
+#endif
+
+    for (; size >= 4 * TYPES_WORD_SIZE; size -= 4 * TYPES_WORD_SIZE, d += 4 * TYPES_WORD_SIZE)
+    {
+      ((types_word *)(void *)d)[0] = word;
+      ((types_word *)(void *)d)[1] = word;
+      ((types_word *)(void *)d)[2] = word;
+      ((types_word *)(void *)d)[3] = word;
+    }
+    for (; size >= TYPES_WORD_SIZE; size -= TYPES_WORD_SIZE, d += TYPES_WORD_SIZE)
+    {
+      *(types_word *)(void *)d = word;
+    }
+  }
+
+  while (size--)
+  {
+    *d++ = value;
+  }
+  return dst;
+}
+
+TYPES_API TYPES_INLINE i32 types_memcmp(const void *a, const void *b, u32 size)
+{
+  const u8 *p = (const u8 *)a;
+  const u8 *q = (const u8 *)b;
+
+  /* The wide loops stop at the first differing block, the byte loop orders it */
+  if (size >= 2 * TYPES_WORD_SIZE && types_mem_words(p, q))
+  {
+#if defined(TYPES_MEM_SSE2)
+    for (; size >= 16; size -= 16, p += 16, q += 16)
+    {
+      __m128i x = _mm_loadu_si128((const __m128i *)(const void *)p);
+      __m128i y = _mm_loadu_si128((const __m128i *)(const void *)q);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF)
+      {
+        break;
+      }
+    }
+#endif
+
+#ifndef TYPES_MEM_UNALIGNED
+    for (; !TYPES_WORD_ALIGNED(p); --size, ++p, ++q)
+    {
+      if (*p != *q)
+      {
+        return (i32)*p - (i32)*q;
+      }
+    }
+#endif
+
+    for (; size >= TYPES_WORD_SIZE; size -= TYPES_WORD_SIZE, p += TYPES_WORD_SIZE, q += TYPES_WORD_SIZE)
+    {
+      if (*(const types_word_unaligned *)(const void *)p != *(const types_word_unaligned *)(const void *)q)
+      {
+        break;
+      }
+    }
+  }
+
+  for (; size; --size, ++p, ++q)
+  {
+    if (*p != *q)
+    {
+      return (i32)*p - (i32)*q;
+    }
+  }
+  return 0;
+}
+
+/* Returns the first byte equal to value or 0 if there is none */
+TYPES_API TYPES_INLINE void *types_memchr(const void *src, u8 value, u32 size)
+{
+  const u8 *p = (const u8 *)src;
+
+  if (size >= 2 * TYPES_WORD_SIZE)
+  {
+    types_uptr ones = (types_uptr)-1 / 0xFF;
+    types_uptr highs = ones << 7;
+    types_uptr pattern = ones * (types_uptr)value;
+
+    /* Aligned words never read past the end of the buffer */
+    for (; !TYPES_WORD_ALIGNED(p); --size, ++p)
+    {
+      if (*p == value)
+      {
+        return (void *)p;
+      }
+    }
+
+#if defined(TYPES_MEM_SSE2)
+    {
+      __m128i v = _mm_set1_epi8((char)value);
+      for (; size >= 16; size -= 16, p += 16)
+      {
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(const void *)p), v)))
+        {
+          break;
+        }
+      }
+    }
+#endif
+
+    /* A byte of x is zero where it matched, (x - ones) & ~x sets its high bit */
+    for (; size >= TYPES_WORD_SIZE; size -= TYPES_WORD_SIZE, p += TYPES_WORD_SIZE)
+    {
+      types_uptr x = *(const types_word *)(const void *)p ^ pattern;
+      if ((x - ones) & ~x & highs)
+      {
+        break;
+      }
+    }
+  }
+
+  for (; size; --size, ++p)
+  {
+    if (*p == value)
+    {
+      return (void *)p;
+    }
+  }
+  return (void *)0;
+}
+
+/* #############################################################################
+ * # Variable Length Integers
+ * #############################################################################
+ *
+ * LEB128 as used by DWARF, WebAssembly and protobuf: 7 bits per byte, least
+ * significant group first, the high bit marks that another byte follows.
+ * The unsigned forms are ULEB128, the signed forms are SLEB128 (sign
+ * extended from the last group). For small negative numbers in a protobuf
+ * style stream zigzag-map them and use the unsigned forms.
+ *
+ * The encoders write at most 5 (u32) or 10 (u64) bytes and return the count.
+ * The decoders return the bytes consumed, or 0 if the input is truncated or
+ * does not fit the type. The u64 forms assemble the two u32 limbs directly,
+ * the emulated u64 never shifts per byte.
+ *
+ * Stream VByte (Lemire et al.) stores arrays of u32: one 2-bit length code
+ * per value packed into control bytes followed by the 1-4 data bytes of each
+ * value. Four values decode with one table-driven byte shuffle (SSSE3 or
+ * AArch64 NEON with TYPES_SIMD), otherwise with four masked loads.
+ */
+#define U32_LEB128_MAX_BYTES 5
+#define U64_LEB128_MAX_BYTES 10
+
+/* Upper bound of the bytes u32_streamvbyte_encode writes for count values */
+#define STREAMVBYTE_MAX_BYTES(count) (((count) + 3) / 4 + 4 * (count))
+
+#if defined(TYPES_SIMD) && defined(__SSSE3__)
+#define TYPES_SVB_SSSE3
+#include <tmmintrin.h>
+#elif defined(TYPES_SIMD) && defined(__aarch64__) && defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#define TYPES_SVB_NEON
+#include <arm_neon.h>
+#endif
+
+/* ---- Zigzag ---- */
+
+/* Maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ... */
+TYPES_API TYPES_INLINE u32 i32_zigzag_encode(i32 x)
+{
+  return ((u32)x << 1) ^ (u32)(x >> 31);
+}
+
+TYPES_API TYPES_INLINE i32 i32_zigzag_decode(u32 x)
+{
+  return (i32)((x >> 1) ^ (0U - (x & 1)));
+}
+
+TYPES_API TYPES_INLINE u64 i64_zigzag_encode(i64 x)
+{
+  u32 sign = (u32)(i64_high(x) >> 31);
+  u32 high = ((u32)i64_high(x) << 1) | (i64_low(x) >> 31);
+  return u64_make(high ^ sign, (i64_low(x) << 1) ^ sign);
+}
+
+TYPES_API TYPES_INLINE i64 i64_zigzag_decode(u64 x)
+{
+  u32 sign = 0U - (u64_low(x) & 1);
+  u32 low = (u64_low(x) >> 1) | (u64_high(x) << 31);
+  return i64_from_u64(u64_make((u64_high(x) >> 1) ^ sign, low ^ sign));
+}
+
+/* ---- LEB128 ---- */
+
+TYPES_API TYPES_INLINE u32 u32_uleb128_encode(u8 *dst, u32 x)
+{
+  u32 n = 0;
+  while (x >= 0x80)
+  {
+    dst[n++] = (u8)(x | 0x80);
+    x >>= 7;
+  }
+  dst[n++] = (u8)x;
+  return n;
+}
+
+/* Packs the 7-bit groups of four bytes (high bits clear) into 28 bits */
+TYPES_API TYPES_INLINE u32 types_leb128_compact(u32 x)
+{
+  x = (x & 0x007F007F) | ((x & 0x7F007F00) >> 1);
+  return (x & 0x00003FFF) | ((x & 0x3FFF0000) >> 2);
+}
+
+/* Bit 7 of the first byte without continuation bit in a little-endian load,
+ * 0 if all four continue.
+ */
+TYPES_API TYPES_INLINE u32 types_leb128_stop(u32 x)
+{
+  u32 stop = ~x & 0x80808080;
+  return stop & (0U - stop);
+}
+
+TYPES_API TYPES_INLINE u32 u32_uleb128_decode(const u8 *src, u32 size, u32 *value)
+{
+  u32 result = 0;
+  u32 i;
+
+  /* Up to 4 bytes in one load, no loop over the bytes */
+  if (size >= 4)
+  {
+    u32 x = u32_load_le(src);
+    u32 stop = types_leb128_stop(x);
+    if (stop)
+    {
+      *value = types_leb128_compact(x & (stop - 1) & 0x7F7F7F7F);
+      return ((u32)u32_ctz(stop) >> 3) + 1;
+    }
+  }
+
+  for (i = 0; i < size && i < U32_LEB128_MAX_BYTES; ++i)
+  {
+    u32 byte = src[i];
+    result |= (byte & 0x7F) << (7 * i);
+    if (byte < 0x80)
+    {
+      /* The fifth byte holds bits 28..31 */
+      if (i == 4 && byte > 0x0F)
+      {
+        return 0;
+      }
+      *value = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+TYPES_API TYPES_INLINE u32 i32_sleb128_encode(u8 *dst, i32 x)
+{
+  u32 n = 0;
+  for (;;)
+  {
+    u32 byte = (u32)x & 0x7F;
+    x >>= 7;
+    /* Done once the rest is the sign extension of bit 6 */
+    if ((x == 0 && !(byte & 0x40)) || (x == -1 && (byte & 0x40)))
+    {
+      dst[n++] = (u8)byte;
+      return n;
+    }
+    dst[n++] = (u8)(byte | 0x80);
+  }
+}
+
+TYPES_API TYPES_INLINE u32 i32_sleb128_decode(const u8 *src, u32 size, i32 *value)
+{
+  u32 result = 0;
+  u32 i;
+  for (i = 0; i < size && i < U32_LEB128_MAX_BYTES; ++i)
+  {
+    u32 byte = src[i];
+    result |= (byte & 0x7F) << (7 * i);
+    if (byte < 0x80)
+    {
+      if (i == 4)
+      {
+        /* Bits 4..6 of the fifth byte must repeat the sign bit 3 */
+        if ((byte & 0x78) != 0 && (byte & 0x78) != 0x78)
+        {
+          return 0;
+        }
+      }
+      else if (byte & 0x40)
+      {
+        result |= ~0U << (7 * (i + 1));
+      }
+      *value = (i32)result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+TYPES_API TYPES_INLINE u32 u64_uleb128_encode(u8 *dst, u64 x)
+{
+  u32 low = u64_low(x);
+  u32 high = u64_high(x);
+  u32 n = 0;
+  while (high != 0 || low >= 0x80)
+  {
+    dst[n++] = (u8)(low | 0x80);
+    low = (low >> 7) | (high << 25);
+    high >>= 7;
+  }
+  dst[n++] = (u8)low;
+  return n;
+}
+
+TYPES_API TYPES_INLINE u32 u64_uleb128_decode(const u8 *src, u32 size, u64 *value)
+{
+  u32 low = 0;
+  u32 high = 0;
+  u32 i;
+
+  /* Up to 8 bytes with two loads, the 28-bit halves become the limbs.
+   * Branch free in the length: stop - 1 keeps all bytes if there is no stop.
+   */
+  if (size >= 8)
+  {
+    u32 a = u32_load_le(src);
+    u32 b = u32_load_le(src + 4);
+    u32 stop_a = types_leb128_stop(a);
+    u32 stop_b = types_leb128_stop(b);
+    if (stop_a | stop_b)
+    {
+      u32 keep_b = stop_a ? 0 : stop_b - 1;
+      u32 upper = types_leb128_compact(b & keep_b & 0x7F7F7F7F);
+      *value = u64_make(upper >> 4, types_leb128_compact(a & (stop_a - 1) & 0x7F7F7F7F) | (upper << 28));
+      return ((u32)(stop_a ? u32_ctz(stop_a) : 32 + u32_ctz(stop_b)) >> 3) + 1;
+    }
+  }
+
+  for (i = 0; i < size && i < U64_LEB128_MAX_BYTES; ++i)
+  {
+    u32 byte = src[i];
+    u32 bits = byte & 0x7F;
+    u32 shift = 7 * i;
+    if (shift < 32)
+    {
+      low |= bits << shift;
+      /* The group at bit 28 straddles the limbs */
+      if (shift > 25)
+      {
+        high |= bits >> (32 - shift);
+      }
+    }
+    else
+    {
+      high |= bits << (shift - 32);
+    }
+    if (byte < 0x80)
+    {
+      /* The tenth byte holds bit 63 only */
+      if (i == 9 && byte > 0x01)
+      {
+        return 0;
+      }
+      *value = u64_make(high, low);
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+TYPES_API TYPES_INLINE u32 i64_sleb128_encode(u8 *dst, i64 x)
+{
+  u32 low = i64_low(x);
+  i32 high = i64_high(x);
+  u32 n = 0;
+  for (;;)
+  {
+    u32 byte = low & 0x7F;
+    low = (low >> 7) | ((u32)high << 25);
+    high >>= 7;
+    if ((high == 0 && low == 0 && !(byte & 0x40)) || (high == -1 && low == 0xFFFFFFFF && (byte & 0x40)))
+    {
+      dst[n++] = (u8)byte;
+      return n;
+    }
+    dst[n++] = (u8)(byte | 0x80);
+  }
+}
+
+TYPES_API TYPES_INLINE u32 i64_sleb128_decode(const u8 *src, u32 size, i64 *value)
+{
+  u32 low = 0;
+  u32 high = 0;
+  u32 i;
+  for (i = 0; i < size && i < U64_LEB128_MAX_BYTES; ++i)
+  {
+    u32 byte = src[i];
+    u32 bits = byte & 0x7F;
+    u32 shift = 7 * i;
+    if (shift < 32)
+    {
+      low |= bits << shift;
+      if (shift > 25)
+      {
+        high |= bits >> (32 - shift);
+      }
+    }
+    else
+    {
+      high |= bits << (shift - 32);
+    }
+    if (byte < 0x80)
+    {
+      shift += 7;
+      if (i == 9)
+      {
+        /* The tenth byte holds bit 63, the rest must repeat it */
+        if (byte != 0x00 && byte != 0x7F)
+        {
+          return 0;
+        }
+      }
+      else if (byte & 0x40)
+      {
+        if (shift < 32)
+        {
+          low |= ~0U << shift;
+          high = ~0U;
+        }
+        else
+        {
+          high |= ~0U << (shift - 32);
+        }
+      }
+      *value = i64_from_u64(u64_make(high, low));
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+/* Decodes count consecutive ULEB128 values, returns the bytes consumed or 0 */
+TYPES_API TYPES_INLINE u32 u64_uleb128_decode_n(u64 *values, u32 count, const u8 *src, u32 size)
+{
+  u32 offset = 0;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    u32 n;
+    /* Single byte values are common in delta streams and well predicted */
+    if (offset < size && src[offset] < 0x80)
+    {
+      values[i] = u64_make(0, src[offset++]);
+      continue;
+    }
+    n = u64_uleb128_decode(src + offset, size - offset, &values[i]);
+    if (n == 0)
+    {
+      return 0;
+    }
+    offset += n;
+  }
+  return offset;
+}
+
+/* ---- Stream VByte ---- */
+
+/* Writes the control bytes then the data bytes, returns the total size.
+ * dst needs STREAMVBYTE_MAX_BYTES(count) bytes.
+ */
+TYPES_API TYPES_INLINE u32 u32_streamvbyte_encode(u8 *dst, const u32 *values, u32 count)
+{
+  u8 *keys = dst;
+  u8 *data = dst + (count + 3) / 4;
+  u32 key = 0;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    u32 x = values[i];
+    u32 code = (u32)(x > 0xFF) + (u32)(x > 0xFFFF) + (u32)(x > 0xFFFFFF);
+    key |= code << ((i & 3) * 2);
+    if ((i & 3) == 3)
+    {
+      keys[i >> 2] = (u8)key;
+      key = 0;
+    }
+    /* Always 4 bytes, the bound leaves room for the unused ones */
+    u32_store_le(data, x);
+    data += code + 1;
+  }
+  if (count & 3)
+  {
+    keys[count >> 2] = (u8)key;
+  }
+  return (u32)(data - dst);
+}
+
+/* Decodes count values from the size bytes at src, returns the bytes
+ * consumed or 0 if src ends early.
+ */
+TYPES_API TYPES_INLINE u32 u32_streamvbyte_decode(u32 *values, u32 count, const u8 *src, u32 size)
+{
+  const u8 *keys = src;
+  const u8 *data;
+  const u8 *end = src + size;
+  u32 i = 0;
+
+  if ((count + 3) / 4 > size)
+  {
+    return 0;
+  }
+  data = src + (count + 3) / 4;
+
+#if defined(TYPES_SVB_SSSE3) || defined(TYPES_SVB_NEON)
+  {
+    /* Shuffle for a pair of values indexed by their two codes (4 bits of a
+     * control byte). 0x80 zeroes the byte, it stays >= 16 when the second
+     * pair is offset by the length of the first.
+     */
+    static const u8 shuffle[16][8] = {
+        {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80},
+        {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80},
+        {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80},
+        {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80},
+        {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80},
+        {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80},
+        {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04},
+        {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05},
+        {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06},
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07}};
+    static const u8 length[16] = {2, 3, 4, 5, 3, 4, 5, 6, 4, 5, 6, 7, 5, 6, 7, 8};
+
+    /* The 16 byte load must stay inside src */
+    for (; i + 4 <= count && end - data >= 16; i += 4)
+    {
+      u32 key = keys[i >> 2];
+      u32 first = key & 15;
+      u32 second = key >> 4;
+#if defined(TYPES_SVB_SSSE3)
+      __m128i lo = _mm_loadl_epi64((const __m128i *)(const void *)shuffle[first]);
+      __m128i hi = _mm_add_epi8(_mm_loadl_epi64((const __m128i *)(const void *)shuffle[second]), _mm_set1_epi8((char)length[first]));
+      __m128i bytes = _mm_loadu_si128((const __m128i *)(const void *)data);
+      _mm_storeu_si128((__m128i *)(void *)(values + i), _mm_shuffle_epi8(bytes, _mm_unpacklo_epi64(lo, hi)));
+#else
+      uint8x8_t lo = vld1_u8(shuffle[first]);
+      uint8x8_t hi = vadd_u8(vld1_u8(shuffle[second]), vdup_n_u8(length[first]));
+      vst1q_u32(values + i, vreinterpretq_u32_u8(vqtbl1q_u8(vld1q_u8(data), vcombine_u8(lo, hi))));
+#endif
+      data += length[first] + length[second];
+    }
+  }
+#else
+  {
+    static const u32 mask[4] = {0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+
+    /* Every value is one 4 byte load, the 16 byte margin keeps them in src */
+    for (; i + 4 <= count && end - data >= 16; i += 4)
+    {
+      u32 key = keys[i >> 2];
+      values[i] = u32_load_le(data) & mask[key & 3];
+      data += (key & 3) + 1;
+      values[i + 1] = u32_load_le(data) & mask[(key >> 2) & 3];
+      data += ((key >> 2) & 3) + 1;
+      values[i + 2] = u32_load_le(data) & mask[(key >> 4) & 3];
+      data += ((key >> 4) & 3) + 1;
+      values[i + 3] = u32_load_le(data) & mask[key >> 6];
+      data += (key >> 6) + 1;
+    }
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    u32 code = ((u32)keys[i >> 2] >> ((i & 3) * 2)) & 3;
+    u32 x = 0;
+    u32 j;
+    if ((u32)(end - data) <= code)
+    {
+      return 0;
+    }
+    for (j = 0; j <= code; ++j)
+    {
+      x |= (u32)data[j] << (8 * j);
+    }
+    values[i] = x;
+    data += code + 1;
+  }
+  return (u32)(data - src);
+}
+
+/* #############################################################################
+ * # Integer Formatting
+ * #############################################################################
+ *
+ * Writes integers as ASCII into a caller buffer and returns the number of
+ * characters. No terminating zero is written, the *_MAX_CHARS macros give
+ * the buffer size needed.
+ *
+ * u64 values are split into 9 digit chunks by two divisions by 10^9 (u32
+ * divisions in the emulated u64), each chunk is written two digits at a
+ * time from a table of the pairs 00..99.
+ */
+#define U32_DEC_MAX_CHARS 10
+#define I32_DEC_MAX_CHARS 11
+#define U64_DEC_MAX_CHARS 20
+#define I64_DEC_MAX_CHARS 20
+#define U32_HEX_MAX_CHARS 8
+#define U64_HEX_MAX_CHARS 16
+
+/* Writes exactly digits decimal digits of x (zero padded) ending before end */
+TYPES_API TYPES_INLINE void types_dec_write(char *end, u32 x, u32 digits)
+{
+  static const char pairs[201] =
+      "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+      "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+  while (digits >= 2)
+  {
+    u32 q = x / 100;
+    u32 r = (x - q * 100) * 2;
+    end -= 2;
+    end[0] = pairs[r];
+    end[1] = pairs[r + 1];
+    x = q;
+    digits -= 2;
+  }
+  if (digits)
+  {
+    end[-1] = (char)('0' + x);
+  }
+}
+
+/* Number of decimal digits, 1 for 0 */
+TYPES_API TYPES_INLINE u32 u32_dec_length(u32 x)
+{
+  static const u32 powers[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  /* log10(2) ~ 1233 / 4096 estimates the length from the bit length, the
+   * table corrects it. x | 1 keeps 0 at one digit (powers >= 10 are even).
+   */
+  u32 t = ((u32)(32 - u32_clz(x | 1)) * 1233) >> 12;
+  return t + 1 - (u32)((x | 1) < powers[t]);
+}
+
+TYPES_API TYPES_INLINE u32 u32_to_dec(char *dst, u32 x)
+{
+  u32 n = u32_dec_length(x);
+  types_dec_write(dst + n, x, n);
+  return n;
+}
+
+TYPES_API TYPES_INLINE u32 i32_to_dec(char *dst, i32 x)
+{
+  if (x < 0)
+  {
+    dst[0] = '-';
+    return 1 + u32_to_dec(dst + 1, 0U - (u32)x);
+  }
+  return u32_to_dec(dst, (u32)x);
+}
+
+TYPES_API TYPES_INLINE u32 u64_to_dec(char *dst, u64 x)
+{
+  u32 low;
+  u32 mid;
+  u32 n;
+  u64 q;
+
+  if (u64_high(x) == 0)
+  {
+    return u32_to_dec(dst, u64_low(x));
+  }
+
+  q = u64_divmod_u32(x, 1000000000, &low);
+  if (u64_high(q) == 0 && u64_low(q) < 1000000000)
+  {
+    n = u32_to_dec(dst, u64_low(q));
+    types_dec_write(dst + n + 9, low, 9);
+    return n + 9;
+  }
+
+  /* At most 18 is left for the leading digits */
+  q = u64_divmod_u32(q, 1000000000, &mid);
+  n = u32_to_dec(dst, u64_low(q));
+  types_dec_write(dst + n + 9, mid, 9);
+  types_dec_write(dst + n + 18, low, 9);
+  return n + 18;
+}
+
+TYPES_API TYPES_INLINE u32 i64_to_dec(char *dst, i64 x)
+{
+  if (i64_high(x) < 0)
+  {
+    dst[0] = '-';
+    /* The magnitude of I64_MIN still fits the u64 */
+    return 1 + u64_to_dec(dst + 1, u64_sub(u64_make(0, 0), u64_from_i64(x)));
+  }
+  return u64_to_dec(dst, u64_from_i64(x));
+}
+
+/* Writes exactly digits lowercase hex digits of x to dst */
+TYPES_API TYPES_INLINE void types_hex_write(char *dst, u32 x, u32 digits)
+{
+  static const char hex[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+  u32 i;
+  for (i = 0; i < digits; ++i)
+  {
+    dst[digits - 1 - i] = hex[x & 15];
+    x >>= 4;
+  }
+}
+
+/* Lowercase hex without prefix or leading zeros */
+TYPES_API TYPES_INLINE u32 u32_to_hex(char *dst, u32 x)
+{
+  /* 1..8 digits. The range is explicit because the compiler cannot bound
+   * u32_clz, GCC -O3 warned about out of bounds writes here.
+   */
+  u32 n = 8 - (((u32)u32_clz(x | 1) >> 2) & 7);
+  types_hex_write(dst, x, n);
+  return n;
+}
+
+TYPES_API TYPES_INLINE u32 u64_to_hex(char *dst, u64 x)
+{
+  u32 n;
+  if (u64_high(x) == 0)
+  {
+    return u32_to_hex(dst, u64_low(x));
+  }
+  n = u32_to_hex(dst, u64_high(x));
+  types_hex_write(dst + n, u64_low(x), 8);
+  return n + 8;
+}
+
+/* #############################################################################
+ * # Integer Parsing
+ * #############################################################################
+ *
+ * Parses the decimal or hex digits at the start of the size bytes at src.
+ * Parsing stops at the first non-digit. Returns the bytes consumed, or 0 if
+ * there is no digit or the number does not fit the type. The signed forms
+ * accept one leading '-' or '+'. Hex takes 0-9, a-f and A-F without prefix.
+ *
+ * Eight characters are checked and converted at a time within a word (SWAR):
+ * one u64 with native 64-bit integers, else two u32 words. The digit count
+ * of a chunk comes from the first non-digit byte, so there is one
+ * multiply-add per chunk instead of per digit and the emulated u64 needs no
+ * per digit u64_mul.
+ */
+
+/* Value of four digits 0..9 in the bytes, the first byte is the most significant */
+TYPES_API TYPES_INLINE u32 types_swar_dec4(u32 x)
+{
+  x = (x * 10 + (x >> 8)) & 0x00FF00FF;
+  return (x * 100 + (x >> 16)) & 0x3FFF;
+}
+
+/* Parses the leading digits of the 8 readable bytes at p without a branch
+ * per digit. Returns their count (0..8) and stores their value.
+ */
+TYPES_API TYPES_INLINE u32 types_swar_dec8(const u8 *p, u32 *value)
+{
+#ifdef TYPES_NATIVE64
+  u64 zeros = u64_make(0x30303030, 0x30303030);
+  u64 nibbles = u64_make(0xF0F0F0F0, 0xF0F0F0F0);
+  u64 x = u64_load_le(p);
+  /* Non-zero high nibble in every non-digit byte, moved to bit 7 */
+  u64 bad = ((x & nibbles) ^ zeros) | (((x + u64_make(0x06060606, 0x06060606)) & nibbles) ^ zeros);
+  u64 stop = ((bad >> 4) + u64_make(0x7F7F7F7F, 0x7F7F7F7F)) & u64_make(0x80808080, 0x80808080);
+  u32 count = (u32)u64_ctz(stop) >> 3;
+  if (count == 0)
+  {
+    *value = 0;
+    return 0;
+  }
+  /* Shifting out the bytes from the first stop on leaves leading zero digits */
+  x = (x - zeros) << (64 - 8 * count);
+  x = ((x & u64_make(0x0F0F0F0F, 0x0F0F0F0F)) * 2561) >> 8;
+  x = ((x & u64_make(0x00FF00FF, 0x00FF00FF)) * 6553601) >> 16;
+  *value = (u32)(((x & u64_make(0x0000FFFF, 0x0000FFFF)) * u64_make(10000, 1)) >> 32);
+  return count;
+#else
+  /* Inverses of 5^k modulo 2^32: an exact multiple of 10^k is divided by
+   * shifting out 2^k and multiplying by the inverse of 5^k.
+   */
+  static const u32 inverses[9] = {0x00000001, 0xCCCCCCCD, 0xC28F5C29, 0x26E978D5, 0x3AFB7E91, 0x0BCBE61D, 0x68C26139, 0xAE8D46A5, 0x22E90E21};
+  u32 a = u32_load_le(p);
+  u32 b = u32_load_le(p + 4);
+  u32 bad_a = ((a & 0xF0F0F0F0) ^ 0x30303030) | (((a + 0x06060606) & 0xF0F0F0F0) ^ 0x30303030);
+  u32 bad_b = ((b & 0xF0F0F0F0) ^ 0x30303030) | (((b + 0x06060606) & 0xF0F0F0F0) ^ 0x30303030);
+  u32 stop_a = ((bad_a >> 4) + 0x7F7F7F7F) & 0x80808080;
+  u32 stop_b = ((bad_b >> 4) + 0x7F7F7F7F) & 0x80808080;
+  u32 count = stop_a ? (u32)u32_ctz(stop_a) >> 3 : 4 + ((u32)u32_ctz(stop_b) >> 3);
+  /* Keep the bytes below the first stop, the rest reads as trailing zeros */
+  u32 keep_a = ((stop_a & (0U - stop_a)) >> 7) - 1;
+  u32 keep_b = (((stop_b & (0U - stop_b)) >> 7) - 1) & (0U - (u32)(stop_a == 0));
+  u32 digits = types_swar_dec4((a - 0x30303030) & keep_a) * 10000 + types_swar_dec4((b - 0x30303030) & keep_b);
+  *value = (digits >> (8 - count)) * inverses[8 - count];
+  return count;
+#endif
+}
+
+/* Bit 7 set in every byte that is a hex digit (bytes must be below 0x80).
+ * Adding 0x80 - lo sets bit 7 of the bytes >= lo without carries.
+ */
+TYPES_API TYPES_INLINE u32 types_swar_hex_letters(u32 x)
+{
+  u32 lower = x | 0x20202020;
+  return ((lower + 0x1F1F1F1F) & ~(lower + 0x19191919)) & 0x80808080;
+}
+
+TYPES_API TYPES_INLINE b32 types_swar_is_hex4(u32 x)
+{
+  u32 digits = ((x + 0x50505050) & ~(x + 0x46464646)) & 0x80808080;
+  return (x & 0x80808080) == 0 && (digits | types_swar_hex_letters(x)) == 0x80808080;
+}
+
+/* Value of four ASCII hex digits, the first byte is the most significant */
+TYPES_API TYPES_INLINE u32 types_swar_hex4(u32 x)
+{
+  /* 'a'/'A' & 15 is 1, letters add 9 */
+  u32 v = (x & 0x0F0F0F0F) + (types_swar_hex_letters(x) >> 7) * 9;
+  v = ((v & 0x000F000F) << 4) | ((v & 0x0F000F00) >> 8);
+  return ((v & 0xFF) << 8) | ((v >> 16) & 0xFF);
+}
+
+/* Digit value of a hex character or 16 */
+TYPES_API TYPES_INLINE u32 types_hex_value(u32 c)
+{
+  u32 d = c - '0';
+  if (d < 10)
+  {
+    return d;
+  }
+  d = (c | 0x20) - 'a';
+  return d < 6 ? d + 10 : 16;
+}
+
+TYPES_API TYPES_INLINE u32 u32_parse_dec(const u8 *src, u32 size, u32 *value)
+{
+  static const u32 powers[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+  u32 result = 0;
+  u32 i = 0;
+
+  /* Every step joins up to 8 digits with one multiply-add */
+  while (size - i >= 8)
+  {
+    u32 chunk;
+    u32 n = types_swar_dec8(src + i, &chunk);
+    if (u32_mul_overflow(result, powers[n], &result) || u32_add_overflow(result, chunk, &result))
+    {
+      return 0;
+    }
+    i += n;
+    if (n < 8)
+    {
+      *value = result;
+      return i;
+    }
+  }
+
+  /* Fewer than 8 bytes left */
+  for (; i < size && (u32)(src[i] - '0') < 10; ++i)
+  {
+    if (u32_mul_overflow(result, 10, &result) || u32_add_overflow(result, (u32)(src[i] - '0'), &result))
+    {
+      return 0;
+    }
+  }
+
+  if (i == 0)
+  {
+    return 0;
+  }
+  *value = result;
+  return i;
+}
+
+TYPES_API TYPES_INLINE u32 u64_parse_dec(const u8 *src, u32 size, u64 *value)
+{
+  static const u32 powers[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+  u64 result = u64_make(0, 0);
+  u32 small = 0;
+  u32 scale = 1;
+  u32 i = 0;
+
+  if (size >= 8)
+  {
+    u32 chunk;
+    u32 n = types_swar_dec8(src, &chunk);
+    result = u64_make(0, chunk);
+    i = n;
+    while (n == 8 && size - i >= 8)
+    {
+      n = types_swar_dec8(src + i, &chunk);
+      /* Fewer than 20 digits always fit, leading zeros included */
+      if (i + n < 20)
+      {
+        result = u64_add_u32(u64_mul_u32(result, powers[n]), chunk);
+      }
+      else if (u64_mul_overflow(result, u64_make(0, powers[n]), &result) || u64_add_overflow(result, u64_make(0, chunk), &result))
+      {
+        return 0;
+      }
+      i += n;
+    }
+    if (n < 8)
+    {
+      if (i == 0)
+      {
+        return 0;
+      }
+      *value = result;
+      return i;
+    }
+  }
+
+  /* Fewer than 8 bytes left, they join with one multiply-add */
+  for (; i < size && (u32)(src[i] - '0') < 10; ++i)
+  {
+    small = small * 10 + (u32)(src[i] - '0');
+    scale *= 10;
+  }
+
+  if (i == 0 || u64_mul_overflow(result, u64_make(0, scale), &result) || u64_add_overflow(result, u64_make(0, small), &result))
+  {
+    return 0;
+  }
+  *value = result;
+  return i;
+}
+
+TYPES_API TYPES_INLINE u32 i32_parse_dec(const u8 *src, u32 size, i32 *value)
+{
+  u32 sign = size > 0 && (src[0] == '-' || src[0] == '+');
+  u32 magnitude = 0;
+  u32 n = u32_parse_dec(src + sign, size - sign, &magnitude);
+  b32 negative = sign && src[0] == '-';
+
+  /* -2^31 is the one magnitude only the negative side holds */
+  if (n == 0 || magnitude > (u32)I32_MAX + (u32)negative)
+  {
+    return 0;
+  }
+  *value = negative ? (i32)(0U - magnitude) : (i32)magnitude;
+  return sign + n;
+}
+
+TYPES_API TYPES_INLINE u32 i64_parse_dec(const u8 *src, u32 size, i64 *value)
+{
+  u32 sign = size > 0 && (src[0] == '-' || src[0] == '+');
+  u64 magnitude = u64_make(0, 0);
+  u32 n = u64_parse_dec(src + sign, size - sign, &magnitude);
+  b32 negative = sign && src[0] == '-';
+
+  if (n == 0 || u64_gt(magnitude, u64_make(0x7FFFFFFF + (u32)negative, negative ? 0 : 0xFFFFFFFF)))
+  {
+    return 0;
+  }
+  *value = i64_from_u64(negative ? u64_sub(u64_make(0, 0), magnitude) : magnitude);
+  return sign + n;
+}
+
+TYPES_API TYPES_INLINE u32 u32_parse_hex(const u8 *src, u32 size, u32 *value)
+{
+  u32 result = 0;
+  u32 small = 0;
+  u32 bits = 0;
+  u32 i = 0;
+
+  /* Leading zeros are skipped, any further 8 digit chunk overflows */
+  while (size - i >= 8 && types_swar_is_hex4(u32_load_le(src + i)) && types_swar_is_hex4(u32_load_le(src + i + 4)))
+  {
+    if (result != 0)
+    {
+      return 0;
+    }
+    result = (types_swar_hex4(u32_load_le(src + i)) << 16) | types_swar_hex4(u32_load_le(src + i + 4));
+    i += 8;
+  }
+
+  if (size - i >= 4 && types_swar_is_hex4(u32_load_le(src + i)))
+  {
+    small = types_swar_hex4(u32_load_le(src + i));
+    bits = 16;
+    i += 4;
+  }
+  for (; i < size && types_hex_value(src[i]) < 16; ++i)
+  {
+    small = (small << 4) | types_hex_value(src[i]);
+    bits += 4;
+  }
+
+  if (i == 0 || (bits && (result >> (32 - bits)) != 0))
+  {
+    return 0;
+  }
+  *value = bits ? (result << bits) | small : result;
+  return i;
+}
+
+TYPES_API TYPES_INLINE u32 u64_parse_hex(const u8 *src, u32 size, u64 *value)
+{
+  u32 high = 0;
+  u32 low = 0;
+  u32 small = 0;
+  u32 bits = 0;
+  u32 i = 0;
+
+  /* Each 8 digit chunk is a whole limb: shift in by moving the limbs */
+  while (size - i >= 8 && types_swar_is_hex4(u32_load_le(src + i)) && types_swar_is_hex4(u32_load_le(src + i + 4)))
+  {
+    if (high != 0)
+    {
+      return 0;
+    }
+    high = low;
+    low = (types_swar_hex4(u32_load_le(src + i)) << 16) | types_swar_hex4(u32_load_le(src + i + 4));
+    i += 8;
+  }
+
+  if (size - i >= 4 && types_swar_is_hex4(u32_load_le(src + i)))
+  {
+    small = types_swar_hex4(u32_load_le(src + i));
+    bits = 16;
+    i += 4;
+  }
+  for (; i < size && types_hex_value(src[i]) < 16; ++i)
+  {
+    small = (small << 4) | types_hex_value(src[i]);
+    bits += 4;
+  }
+
+  if (i == 0 || (bits && (high >> (32 - bits)) != 0))
+  {
+    return 0;
+  }
+  if (bits)
+  {
+    high = (high << bits) | (low >> (32 - bits));
+    low = (low << bits) | small;
+  }
+  *value = u64_make(high, low);
+  return i;
+}
+
+/* #############################################################################
+ * # Float Conversions
+ * #############################################################################
+ *
+ * Conversions between f32/f64 and the 64-bit integers with the same results
+ * for native and emulated u64. They build or take apart the IEEE 754 bits
+ * with integer operations (doubles are assumed to use the byte order of the
+ * integers), the emulated u64 needs no FPU multiply or runtime library call.
+ *
+ * Integers round to the nearest float, ties to even (double_from_u64 and
+ * double_from_i64 are the f64 forms). Floats truncate toward zero, the
+ * _round forms round to nearest, ties to even. Both wrap modulo 2^64 like an
+ * integer cast of a wider type (negative values give the two's complement),
+ * NaN and infinity give 0. The _sat forms truncate and clamp to the range of
+ * the type instead, NaN gives 0. f32 values convert to f64 exactly, pass
+ * (f64)x.
+ */
+/* ---- Bit Access ---- */
+TYPES_API TYPES_INLINE u32 f32_to_bits(f32 x)
+{
+  union
+  {
+    f32 f;
+    u32 u;
+  } v;
+  v.f = x;
+  return v.u;
+}
+
+TYPES_API TYPES_INLINE f32 f32_from_bits(u32 x)
+{
+  union
+  {
+    f32 f;
+    u32 u;
+  } v;
+  v.u = x;
+  return v.f;
+}
+
+#ifndef TYPES_NATIVE64
+/* Index of the high u32 word of a f64 in memory, folded to a constant */
+TYPES_API TYPES_INLINE u32 types_f64_high_word(void)
+{
+  union
+  {
+    u32 u;
+    u8 b[4];
+  } probe;
+  probe.u = 1;
+  return probe.b[0];
+}
+#endif
+
+TYPES_API TYPES_INLINE u64 f64_to_bits(f64 x)
+{
+#ifdef TYPES_NATIVE64
+  union
+  {
+    f64 f;
+    u64 u;
+  } v;
+  v.f = x;
+  return v.u;
+#else
+  union
+  {
+    f64 f;
+    u32 w[2];
+  } v;
+  u32 high = types_f64_high_word();
+  v.f = x;
+  return u64_make(v.w[high], v.w[high ^ 1]);
+#endif
+}
+
+TYPES_API TYPES_INLINE f64 f64_from_bits(u64 x)
+{
+#ifdef TYPES_NATIVE64
+  union
+  {
+    f64 f;
+    u64 u;
+  } v;
+  v.u = x;
+  return v.f;
+#else
+  union
+  {
+    f64 f;
+    u32 w[2];
+  } v;
+  u32 high = types_f64_high_word();
+  v.w[high] = x.high;
+  v.w[high ^ 1] = x.low;
+  return v.f;
+#endif
+}
+
+/* ---- Integer to Float ---- */
+TYPES_API TYPES_INLINE f32 f32_from_u64(u64 x)
+{
+#ifdef TYPES_NATIVE64
+  return (f32)x;
+#else
+  u32 high = x.high;
+  u32 low = x.low;
+  u32 bits;
+  u32 rest;
+  int n;
+
+  if (high == 0)
+  {
+    return (f32)low;
+  }
+
+  /* Move the leading 1 to bit 63, the upper 24 bits are the significand */
+  n = u32_clz(high);
+  high = (high << n) | ((low >> 1) >> (31 - n));
+  low <<= n;
+  rest = high & 0xFF;
+
+  /* The leading 1 adds one to the exponent field, a rounding carry out of
+   * the significand moves on into the exponent the same way.
+   */
+  bits = ((u32)(189 - n) << 23) + (high >> 8);
+  if (rest > 0x80 || (rest == 0x80 && (low != 0 || (bits & 1))))
+  {
+    bits += 1;
+  }
+  return f32_from_bits(bits);
+#endif
+}
+
+TYPES_API TYPES_INLINE f32 f32_from_i64(i64 x)
+{
+#ifdef TYPES_NATIVE64
+  return (f32)x;
+#else
+  f32 r = f32_from_u64(u64_from_i64(x.high < 0 ? i64_neg(x) : x));
+  return x.high < 0 ? -r : r;
+#endif
+}
+
+/* ---- Float to Integer ---- */
+#ifndef TYPES_NATIVE64
+/* high:low shifted right by any count, without a branch */
+TYPES_API TYPES_INLINE u64 types_f64_shr(u32 high, u32 low, u32 n)
+{
+  u32 s = n & 31;
+  u32 keep = 0U - (u32)((n >> 5) == 0);
+  u32 word = 0U - (u32)((n >> 5) == 1);
+  u32 upper = high >> s;
+  u32 lower = (low >> s) | ((high << 1) << (31 - s));
+  return u64_make(upper & keep, (lower & keep) | (upper & word));
 }
+#endif
 
-TYPES_API TYPES_INLINE i64 i64_shr(i64 a, int n)
+/* |x| truncated or rounded to an integer, modulo 2^64 */
+TYPES_API TYPES_INLINE u64 types_f64_magnitude(u64 bits, b32 round)
 {
-  i64 res = a;
-  if (n >= 64)
+#ifdef TYPES_NATIVE64
+  int shift = 1075 - (int)((bits >> 52) & 0x7FF);
+  u64 m = ((bits << 12) >> 12) | ((u64)1 << 52);
+  u64 r;
+
+  /* Left shifts of 64 and more give 0, also for NaN and infinity */
+  if (shift <= 0)
   {
-    res.high = (a.high < 0) ? -1 : 0;
-    res.low = 0;
+    return u64_shl(m, -shift);
   }
-  else if (n >= 32)
+
+  r = u64_shr(m, shift);
+  if (round && shift < 64)
   {
-    res.low = (u32)a.high >> (n - 32);
-    res.high = (a.high < 0) ? -1 : 0;
+    u64 rest = m - (r << shift);
+    u64 half = (u64)1 << (shift - 1);
+    r += (rest > half || (rest == half && (r & 1)));
   }
-  else if (n > 0)
+  return r;
+#else
+  /* The significand moves to the top bits, then the value is m >> shift */
+  u32 high = bits.high;
+  u32 low = bits.low;
+  int shift = 1086 - (int)((high >> 20) & 0x7FF);
+  u32 mh = 0x80000000U | (high << 11) | (low >> 21);
+  u32 ml = low << 11;
+  u64 q;
+  u32 sticky;
+
+  /* 2^63 and above, NaN and infinity shift out to 0 */
+  if (shift <= 0)
   {
-    res.low = (a.low >> n) | ((u32)a.high << (32 - n));
-    res.high >>= n;
+    return u64_shl(u64_make(mh, ml), -shift);
   }
-  return res;
+  if (!round)
+  {
+    return types_f64_shr(mh, ml, (u32)shift);
+  }
+
+  /* q keeps the first bit shifted out, the sticky bit is set if any bit
+   * below it is, then ties go to the even result.
+   */
+  q = types_f64_shr(mh, ml, (u32)shift - 1);
+  sticky = (u32)((ml ? u32_ctz(ml) : 32 + u32_ctz(mh)) < shift - 1);
+  return u64_add_u32(u64_shr(q, 1), q.low & ((q.low >> 1) | sticky) & 1);
+#endif
 }
 
-TYPES_API TYPES_INLINE i64 i64_neg(i64 a)
+TYPES_API TYPES_INLINE u64 types_f64_to_u64(f64 x, b32 round)
 {
-  u64 zero = {0, 0};
-  u64 ua;
-  u64 ur;
-  i64 res;
-
-  ua.low = a.low;
-  ua.high = (u32)a.high;
-
-  ur = u64_sub(zero, ua);
-
-  res.low = ur.low;
-  res.high = (i32)ur.high;
+  u64 bits = f64_to_bits(x);
+  u32 sign = 0U - (u64_high(bits) >> 31);
+  u64 negate = u64_make(sign, sign);
 
-  return res;
+  /* Two's complement without a branch on the sign: (r ^ -1) - -1 = -r */
+  return u64_sub(u64_xor(types_f64_magnitude(bits, round), negate), negate);
 }
 
-TYPES_API TYPES_INLINE i64 i64_mul(i64 a, i64 b)
+TYPES_API TYPES_INLINE u64 u64_from_f64(f64 x)
 {
-  int neg = 0;
-  u64 ua, ub, ur;
-  i64 res;
-
-  if (a.high < 0)
+#ifdef TYPES_NATIVE64
+  if (x > -1.0 && x < 18446744073709551616.0)
   {
-    a = i64_neg(a);
-    neg = !neg;
+    return (u64)x;
   }
-  if (b.high < 0)
+#endif
+  return types_f64_to_u64(x, 0);
+}
+
+TYPES_API TYPES_INLINE i64 i64_from_f64(f64 x)
+{
+#ifdef TYPES_NATIVE64
+  if (x >= -9223372036854775808.0 && x < 9223372036854775808.0)
   {
-    b = i64_neg(b);
-    neg = !neg;
+    return (i64)x;
   }
+#endif
+  return i64_from_u64(types_f64_to_u64(x, 0));
+}
 
-  ua.high = (u32)a.high;
-  ua.low = a.low;
-  ub.high = (u32)b.high;
-  ub.low = b.low;
+TYPES_API TYPES_INLINE u64 u64_from_f64_round(f64 x)
+{
+  return types_f64_to_u64(x, 1);
+}
 
-  ur = u64_mul(ua, ub);
+TYPES_API TYPES_INLINE i64 i64_from_f64_round(f64 x)
+{
+  return i64_from_u64(types_f64_to_u64(x, 1));
+}
 
-  if (neg)
+TYPES_API TYPES_INLINE u64 u64_from_f64_sat(f64 x)
+{
+#ifdef TYPES_NATIVE64
+  /* NaN fails every compare */
+  return (x > -1.0) ? ((x < 18446744073709551616.0) ? (u64)x : ~(u64)0) : 0;
+#else
+  u64 bits = f64_to_bits(x);
+  u32 positive = (bits.high >> 31) - 1U;
+  u64 r;
+  if (x != x)
   {
-    u64 zero = {0, 0};
-    ur = u64_sub(zero, ur);
+    return u64_from_u32(0);
   }
-
-  res.high = (i32)ur.high;
-  res.low = ur.low;
-  return res;
+  /* |x| of 2^64 and above */
+  if (((bits.high >> 20) & 0x7FF) >= 1023 + 64)
+  {
+    return u64_make(positive, positive);
+  }
+  r = types_f64_magnitude(bits, 0);
+  return u64_make(r.high & positive, r.low & positive);
+#endif
 }
 
-TYPES_API TYPES_INLINE i64 i64_div(i64 a, i64 b)
+TYPES_API TYPES_INLINE i64 i64_from_f64_sat(f64 x)
 {
-  int neg = 0;
-  u64 ua, ub, uq;
-  i64 res;
-
-  if (a.high < 0)
+#ifdef TYPES_NATIVE64
+  if (x >= -9223372036854775808.0)
   {
-    a = i64_neg(a);
-    neg = !neg;
+    return (x < 9223372036854775808.0) ? (i64)x : i64_make(I32_MAX, U32_MAX);
   }
-  if (b.high < 0)
+  return (x == x) ? i64_make(I32_MIN, 0) : 0;
+#else
+  u32 high = f64_to_bits(x).high;
+  if (x != x)
   {
-    b = i64_neg(b);
-    neg = !neg;
+    return i64_make(0, 0);
   }
+  /* |x| of 2^63 and above, -2^63 itself clamps to I64_MIN as well */
+  if (((high >> 20) & 0x7FF) >= 1023 + 63)
+  {
+    return (high >> 31) ? i64_make(I32_MIN, 0) : i64_make(I32_MAX, U32_MAX);
+  }
+  return i64_from_u64(types_f64_to_u64(x, 0));
+#endif
+}
 
-  ua.high = (u32)a.high;
-  ua.low = a.low;
-  ub.high = (u32)b.high;
-  ub.low = b.low;
-
-  uq = u64_div(ua, ub);
+/* ---- Arrays ---- */
+TYPES_API TYPES_INLINE void double_from_u64_n(f64 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    r[i] = double_from_u64(a[i]);
+  }
+}
 
-  if (neg)
+TYPES_API TYPES_INLINE void double_from_i64_n(f64 *TYPES_RESTRICT r, const i64 *TYPES_RESTRICT a, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
   {
-    u64 zero = {0, 0};
-    uq = u64_sub(zero, uq);
+    r[i] = double_from_i64(a[i]);
   }
+}
 
-  res.high = (i32)uq.high;
-  res.low = uq.low;
-  return res;
+TYPES_API TYPES_INLINE void f32_from_u64_n(f32 *TYPES_RESTRICT r, const u64 *TYPES_RESTRICT a, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    r[i] = f32_from_u64(a[i]);
+  }
 }
 
-TYPES_API TYPES_INLINE i64 i64_mod(i64 a, i64 b)
+TYPES_API TYPES_INLINE void f32_from_i64_n(f32 *TYPES_RESTRICT r, const i64 *TYPES_RESTRICT a, u32 count)
 {
-  i64 q = i64_div(a, b);
-  i64 p = i64_mul(q, b);
-  return i64_sub(a, p);
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    r[i] = f32_from_i64(a[i]);
+  }
 }
 
-/* ---- Unsigned Comparisons ---- */
-TYPES_API TYPES_INLINE int u64_eq(u64 a, u64 b)
+TYPES_API TYPES_INLINE void u64_from_f64_n(u64 *TYPES_RESTRICT r, const f64 *TYPES_RESTRICT a, u32 count)
 {
-  return a.high == b.high && a.low == b.low;
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    r[i] = u64_from_f64(a[i]);
+  }
 }
 
-TYPES_API TYPES_INLINE int u64_ne(u64 a, u64 b)
+TYPES_API TYPES_INLINE void u64_from_f64_round_n(u64 *TYPES_RESTRICT r, const f64 *TYPES_RESTRICT a, u32 count)
 {
-  return !u64_eq(a, b);
+  u32 i;
+  for (i = 0; i < count; ++i)
+  {
+    r[i] = u64_from_f64_round(a[i]);
+  }
 }
 
-TYPES_API TYPES_INLINE int u64_lt(u64 a, u64 b)
+TYPES_API TYPES_INLINE void u64_from_f64_sat_n(u64 *TYPES_RESTRICT r, const f64 *TYPES_RESTRICT a, u32 count)
 {
-  if (a.high < b.high)
+  u32 i;
+  for (i = 0; i < count; ++i)
   {
-    return 1;
+    r[i] = u64_from_f64_sat(a[i]);
   }
-  if (a.high > b.high)
+}
+
+TYPES_API TYPES_INLINE void i64_from_f64_n(i64 *TYPES_RESTRICT r, const f64 *TYPES_RESTRICT a, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
   {
-    return 0;
+    r[i] = i64_from_f64(a[i]);
   }
-  return a.low < b.low;
 }
 
-TYPES_API TYPES_INLINE int u64_le(u64 a, u64 b)
+TYPES_API TYPES_INLINE void i64_from_f64_round_n(i64 *TYPES_RESTRICT r, const f64 *TYPES_RESTRICT a, u32 count)
 {
-  if (a.high < b.high)
+  u32 i;
+  for (i = 0; i < count; ++i)
   {
-    return 1;
+    r[i] = i64_from_f64_round(a[i]);
   }
-  if (a.high > b.high)
+}
+
+TYPES_API TYPES_INLINE void i64_from_f64_sat_n(i64 *TYPES_RESTRICT r, const f64 *TYPES_RESTRICT a, u32 count)
+{
+  u32 i;
+  for (i = 0; i < count; ++i)
   {
-    return 0;
+    r[i] = i64_from_f64_sat(a[i]);
   }
-  return a.low <= b.low;
 }
 
-TYPES_API TYPES_INLINE int u64_gt(u64 a, u64 b)
+/* #############################################################################
+ * # f32 Math
+ * #############################################################################
+ *
+ * sqrt, exp, log, sin and cos for f32 without libm. Max error measured over
+ * all f32 inputs against the exact result:
+ *
+ *   f32_sqrt   0.5 ulp (correctly rounded)
+ *   f32_rsqrt  0.501 ulp
+ *   f32_exp    0.992 ulp
+ *   f32_log    0.834 ulp
+ *   f32_sin    0.501 ulp
+ *   f32_cos    0.501 ulp
+ *
+ * Special values follow C99: NaN in gives NaN, sqrt and log of a negative
+ * number give NaN, log(0) = -inf, exp(-inf) = 0, sin and cos of infinity
+ * give NaN. sqrt, rsqrt, sin and cos evaluate in f64 internally, exp and log
+ * use minimax polynomials in f32 after an exact range reduction.
+ *
+ * The functions are straight line code, special cases and range limits are
+ * selected on the bits instead of branched to, so the _n forms vectorize.
+ * The one exception is sin and cos from |x| >= 2^28 on, which take a scalar
+ * Payne-Hanek reduction.
+ * They run blocks of 16 because GCC at -O2 only vectorizes loops with a
+ * fixed trip count. f32_rsqrt_fast is the classic bit trick with one Newton
+ * step (relative error below 0.18%) for positive normal x only.
+ */
+/* Largest finite and smallest normal f32 */
+#define F32_MAX 3.40282347e+38f
+#define F32_MIN 1.17549435e-38f
+
+/* cond ? a : b on the bits. GCC moves the work for a plain ?: of floats
+ * into branches, which the vectorizer then rejects.
+ */
+TYPES_API TYPES_INLINE f32 types_f32_select(b32 cond, f32 a, f32 b)
 {
-  return u64_lt(b, a);
+  u32 mask = 0U - (u32)cond;
+  return f32_from_bits((f32_to_bits(a) & mask) | (f32_to_bits(b) & ~mask));
 }
 
-TYPES_API TYPES_INLINE int u64_ge(u64 a, u64 b)
+/* 2^e for e in -126..127 */
+TYPES_API TYPES_INLINE f32 types_f32_pow2(i32 e)
 {
-  return u64_le(b, a);
+  return f32_from_bits((u32)(e + 127) << 23);
 }
 
-/* ---- Signed Comparisons ---- */
-TYPES_API TYPES_INLINE int i64_eq(i64 a, i64 b)
+/* ---- Square Root ---- */
+/* 1/sqrt(x) to 2^-33 relative, x positive and normal */
+TYPES_API TYPES_INLINE f64 types_f32_rsqrt_f64(f32 x)
 {
-  return a.high == b.high && a.low == b.low;
+  f64 d = (f64)x;
+  f64 y = (f64)f32_from_bits(0x5F3759DF - (f32_to_bits(x) >> 1));
+  y = y * (1.5 - 0.5 * d * y * y);
+  y = y * (1.5 - 0.5 * d * y * y);
+  return y * (1.5 - 0.5 * d * y * y);
 }
 
-TYPES_API TYPES_INLINE int i64_ne(i64 a, i64 b)
+TYPES_API TYPES_INLINE f32 f32_sqrt(f32 x)
 {
-  return !i64_eq(a, b);
+  /* Subnormals are scaled up by 2^24 for the first guess */
+  b32 tiny = x < F32_MIN;
+  f32 xs = x * types_f32_pow2(24 * tiny);
+  f64 d = (f64)xs;
+  f64 y = types_f32_rsqrt_f64(xs);
+  f64 s = d * y;
+  f32 r;
+
+  /* One more step on sqrt itself takes s below the distance any sqrt has
+   * to an f32 rounding boundary, so the conversion rounds correctly.
+   */
+  s = s + 0.5 * y * (d - s * s);
+  r = (f32)s * types_f32_pow2(-12 * tiny);
+
+  /* +-0 and inf stay, negative numbers give NaN */
+  return types_f32_select((x > 0.0f) & (x <= F32_MAX), r, types_f32_select(x >= 0.0f, x, f32_from_bits(0x7FC00000)));
 }
 
-TYPES_API TYPES_INLINE int i64_lt(i64 a, i64 b)
+TYPES_API TYPES_INLINE f32 f32_rsqrt(f32 x)
 {
-  if (a.high < b.high)
-  {
-    return 1;
-  }
-  if (a.high > b.high)
+  b32 tiny = x < F32_MIN;
+  f32 r = (f32)types_f32_rsqrt_f64(x * types_f32_pow2(24 * tiny)) * types_f32_pow2(12 * tiny);
+
+  /* 1/sqrt(+-0) = +-inf, 1/sqrt(inf) = 0 */
+  f32 special = types_f32_select(x > 0.0f, 0.0f, f32_from_bits(0x7FC00000));
+  special = types_f32_select(x == 0.0f, f32_from_bits(0x7F800000 | f32_to_bits(x)), special);
+  return types_f32_select((x > 0.0f) & (x <= F32_MAX), r, special);
+}
+
+TYPES_API TYPES_INLINE f32 f32_rsqrt_fast(f32 x)
+{
+  f32 y = f32_from_bits(0x5F375A86 - (f32_to_bits(x) >> 1));
+  return y * (1.5f - 0.5f * x * y * y);
+}
+
+/* ---- Exponential and Logarithm ---- */
+TYPES_API TYPES_INLINE f32 f32_exp(f32 x)
+{
+  /* Clamped (NaN too) so n fits the two scale factors, the result at the
+   * limits already rounds to 0 or inf.
+   */
+  f32 c = types_f32_select(x > -104.0f, x, -104.0f);
+  f32 t;
+  f32 r;
+  f32 p;
+  i32 n;
+  i32 h;
+
+  c = types_f32_select(c < 89.0f, c, 89.0f);
+  t = c * 1.44269504f;
+  n = (i32)(t + ((t < 0.0f) ? -0.5f : 0.5f));
+
+  /* r = c - n * ln(2) with ln(2) split in an exact and a small part */
+  r = c - (f32)n * 0.693359375f;
+  r = r + (f32)n * 2.12194440e-4f;
+
+  p = 1.9875691500e-4f;
+  p = p * r + 1.3981999507e-3f;
+  p = p * r + 8.3334519073e-3f;
+  p = p * r + 4.1665795894e-2f;
+  p = p * r + 1.6666665459e-1f;
+  p = p * r + 5.0000001201e-1f;
+  p = p * r * r + r + 1.0f;
+
+  /* 2^n as two factors, so subnormal results are rounded only once */
+  h = n / 2;
+  p = p * types_f32_pow2(h) * types_f32_pow2(n - h);
+  return types_f32_select(x == x, p, x);
+}
+
+TYPES_API TYPES_INLINE f32 f32_log(f32 x)
+{
+  /* x = m * 2^e with m in [sqrt(1/2), sqrt(2)), subnormals scaled by 2^24 */
+  b32 tiny = x < F32_MIN;
+  u32 bits = f32_to_bits(x * types_f32_pow2(24 * tiny));
+  i32 e = (i32)(bits >> 23) - 127 - 24 * tiny;
+  f32 m = f32_from_bits((bits & 0x007FFFFF) | 0x3F800000);
+  b32 big = m > 1.41421356f;
+  f32 special;
+  f32 f;
+  f32 z;
+  f32 p;
+  f32 r;
+
+  m = m * types_f32_pow2(-big);
+  e += big;
+  f = m - 1.0f;
+  z = f * f;
+
+  p = 7.0376836292e-2f;
+  p = p * f - 1.1514610310e-1f;
+  p = p * f + 1.1676998740e-1f;
+  p = p * f - 1.2420140846e-1f;
+  p = p * f + 1.4249322787e-1f;
+  p = p * f - 1.6668057665e-1f;
+  p = p * f + 2.0000714765e-1f;
+  p = p * f - 2.4999993993e-1f;
+  p = p * f + 3.3333331174e-1f;
+
+  /* log(m) + e * ln(2) with ln(2) split in an exact and a small part */
+  r = f * z * p - 2.12194440e-4f * (f32)e - 0.5f * z;
+  r = f + r + 0.693359375f * (f32)e;
+
+  /* log(+-0) = -inf, log(inf) = inf, negative numbers give NaN */
+  special = types_f32_select(x > 0.0f, x, f32_from_bits(0x7FC00000));
+  special = types_f32_select(x == 0.0f, f32_from_bits(0xFF800000), special);
+  return types_f32_select((x > 0.0f) & (x <= F32_MAX), r, special);
+}
+
+/* ---- Trigonometry ---- */
+/* sin(r + q * pi/2) for |r| <= pi/4: odd quadrants take the cos polynomial,
+ * the upper two flip the sign.
+ */
+TYPES_API TYPES_INLINE f32 types_f32_sin_poly(f64 r, u32 q)
+{
+  f64 z = r * r;
+  f64 w = z * z;
+  f32 s = (f32)((r + r * z * (-0.166666666416265235595 + z * 0.0083333293858894631756)) + r * z * w * (-0.000198393348360966317347 + z * 0.0000027183114939898219064));
+  f32 c = (f32)(((1.0 + z * -0.499999997251031003120) + w * 0.0416666233237390631894) + w * z * (-0.00138867637746099294692 + z * 0.0000243904487962774090654));
+  f32 v = types_f32_select((b32)(q & 1), c, s);
+  return f32_from_bits(f32_to_bits(v) ^ ((q & 2) << 30));
+}
+
+/* 2^28 <= |x| < inf, where n * pi/2 below is no longer exact */
+TYPES_API TYPES_INLINE b32 types_f32_sin_is_large(f32 x)
+{
+  return (f32_to_bits(x) & 0x7FFFFFFF) - 0x4D800000U < 0x7F800000U - 0x4D800000U;
+}
+
+/* sin(x + offset * pi/2) for |x| < 2^28: x is reduced by n * pi/2 in f64 to
+ * |r| <= pi/4. Large x give 0 here, f32_sin and f32_cos pass them on to
+ * types_f32_sin_large.
+ */
+TYPES_API TYPES_INLINE f32 types_f32_sin_quadrant(f32 x, u32 offset)
+{
+  b32 huge = !((x > -268435456.0f) & (x < 268435456.0f));
+  f64 d = (f64)types_f32_select(huge, 0.0f, x);
+  f64 t = d * 0.63661977236758134308;
+  i32 n = (i32)(t + ((t < 0.0) ? -0.5 : 0.5));
+  f64 r;
+  f32 v;
+
+  /* pi/2 in 25 bits and the rest */
+  r = d - (f64)n * 1.57079631090164184570e+00;
+  r = r - (f64)n * 1.58932547735281966916e-08;
+  v = types_f32_sin_poly(r, (u32)n + offset);
+
+  /* inf - inf and NaN give NaN */
+  return types_f32_select(x - x == 0.0f, types_f32_select(huge, 0.0f, v), x - x);
+}
+
+/* Payne-Hanek reduction for large finite x. x = m * 2^e is multiplied by the
+ * 96 bit window of 2/pi that the exponent selects: bits of 2/pi above the
+ * window only add multiples of 4 quadrants, bits below it are lost in
+ * rounding. The top 2 bits of the 64 bit product are the quadrant, the other
+ * 62 the remainder.
+ */
+TYPES_API TYPES_INLINE f32 types_f32_sin_large(f32 x, u32 offset)
+{
+  /* 2/pi, the first word holds 2^-1 .. 2^-32 */
+  static const u32 two_over_pi[7] = {0xA2F9836E, 0x4E441529, 0xFC2757D1, 0xF534DDC0, 0xDB629599, 0x3C439041, 0xFE5163AB};
+  u32 bits = f32_to_bits(x);
+  u32 m = (bits & 0x007FFFFF) | 0x00800000;
+  u32 p = ((bits >> 23) & 0xFF) - 152; /* bit offset of the window in 2/pi */
+  u32 k = p >> 5;
+  u32 s = p & 31;
+  u32 d2 = (two_over_pi[k] << s) | ((two_over_pi[k + 1] >> 1) >> (31 - s));
+  u32 d1 = (two_over_pi[k + 1] << s) | ((two_over_pi[k + 2] >> 1) >> (31 - s));
+  u32 d0 = (two_over_pi[k + 2] << s) | ((two_over_pi[k + 3] >> 1) >> (31 - s));
+  u32 h0, h1, low, high, q;
+  f64 r;
+
+  /* Bits 32..95 of m * d2:d1:d0, the quadrant in the top 2 bits */
+  types_u32_mul_wide(m, d0, &h0);
+  low = types_u32_mul_wide(m, d1, &h1) + h0;
+  high = h1 + m * d2 + (u32)(low < h0);
+
+  /* Round to the nearest quadrant, the remainder is in [-1/2, 1/2) of one */
+  high += 0x20000000;
+  q = high >> 30;
+  r = ((f64)((i32)(high & 0x3FFFFFFF) - 0x20000000) * 4294967296.0 + (f64)low) * 3.4061215800865545e-19; /* pi/2 * 2^-62 */
+
+  /* sin(-x) = -sin(x): the remainder and the quadrant change sign */
+  if (bits >> 31)
   {
-    return 0;
+    r = -r;
+    q = 0U - q;
   }
-  return a.low < b.low;
+  return types_f32_sin_poly(r, q + offset);
 }
 
-TYPES_API TYPES_INLINE int i64_le(i64 a, i64 b)
+TYPES_API TYPES_INLINE f32 f32_sin(f32 x)
 {
-  if (a.high < b.high)
+  return types_f32_sin_is_large(x) ? types_f32_sin_large(x, 0) : types_f32_sin_quadrant(x, 0);
+}
+
+TYPES_API TYPES_INLINE f32 f32_cos(f32 x)
+{
+  return types_f32_sin_is_large(x) ? types_f32_sin_large(x, 1) : types_f32_sin_quadrant(x, 1);
+}
+
+/* ---- Arrays ---- */
+TYPES_API TYPES_INLINE void f32_sqrt_n(f32 *TYPES_RESTRICT r, const f32 *TYPES_RESTRICT a, u32 count)
+{
+  u32 i = 0;
+  u32 j;
+  for (; i + 16 <= count; i += 16)
   {
-    return 1;
+    f32 *TYPES_RESTRICT out = r + i;
+    const f32 *TYPES_RESTRICT in = a + i;
+    for (j = 0; j < 16; ++j)
+    {
+      out[j] = f32_sqrt(in[j]);
+    }
   }
-  if (a.high > b.high)
+  for (; i < count; ++i)
   {
-    return 0;
+    r[i] = f32_sqrt(a[i]);
   }
-  return a.low <= b.low;
 }
 
-TYPES_API TYPES_INLINE int i64_gt(i64 a, i64 b)
+TYPES_API TYPES_INLINE void f32_rsqrt_n(f32 *TYPES_RESTRICT r, const f32 *TYPES_RESTRICT a, u32 count)
 {
-  return i64_lt(b, a);
+  u32 i = 0;
+  u32 j;
+  for (; i + 16 <= count; i += 16)
+  {
+    f32 *TYPES_RESTRICT out = r + i;
+    const f32 *TYPES_RESTRICT in = a + i;
+    for (j = 0; j < 16; ++j)
+    {
+      out[j] = f32_rsqrt(in[j]);
+    }
+  }
+  for (; i < count; ++i)
+  {
+    r[i] = f32_rsqrt(a[i]);
+  }
 }
 
-TYPES_API TYPES_INLINE int i64_ge(i64 a, i64 b)
+TYPES_API TYPES_INLINE void f32_rsqrt_fast_n(f32 *TYPES_RESTRICT r, const f32 *TYPES_RESTRICT a, u32 count)
 {
-  return i64_le(b, a);
+  u32 i = 0;
+  u32 j;
+  for (; i + 16 <= count; i += 16)
+  {
+    f32 *TYPES_RESTRICT out = r + i;
+    const f32 *TYPES_RESTRICT in = a + i;
+    for (j = 0; j < 16; ++j)
+    {
+      out[j] = f32_rsqrt_fast(in[j]);
+    }
+  }
+  for (; i < count; ++i)
+  {
+    r[i] = f32_rsqrt_fast(a[i]);
+  }
 }
 
-/* Conversion functions */
-TYPES_API TYPES_INLINE u64 u64_from_u32(u32 x)
+TYPES_API TYPES_INLINE void f32_exp_n(f32 *TYPES_RESTRICT r, const f32 *TYPES_RESTRICT a, u32 count)
 {
-  u64 r;
-  r.high = 0;
-  r.low = x;
-  return r;
+  u32 i = 0;
+  u32 j;
+  for (; i + 16 <= count; i += 16)
+  {
+    f32 *TYPES_RESTRICT out = r + i;
+    const f32 *TYPES_RESTRICT in = a + i;
+    for (j = 0; j < 16; ++j)
+    {
+      out[j] = f32_exp(in[j]);
+    }
+  }
+  for (; i < count; ++i)
+  {
+    r[i] = f32_exp(a[i]);
+  }
 }
 
-TYPES_API TYPES_INLINE i64 i64_from_i32(i32 x)
+TYPES_API TYPES_INLINE void f32_log_n(f32 *TYPES_RESTRICT r, const f32 *TYPES_RESTRICT a, u32 count)
 {
-  i64 r;
-  r.high = (x < 0) ? -1 : 0;
-  r.low = (u32)x;
-  return r;
+  u32 i = 0;
+  u32 j;
+  for (; i + 16 <= count; i += 16)
+  {
+    f32 *TYPES_RESTRICT out = r + i;
+    const f32 *TYPES_RESTRICT in = a + i;
+    for (j = 0; j < 16; ++j)
+    {
+      out[j] = f32_log(in[j]);
+    }
+  }
+  for (; i < count; ++i)
+  {
+    r[i] = f32_log(a[i]);
+  }
 }
 
-TYPES_API TYPES_INLINE double double_from_u64(u64 x)
+TYPES_API TYPES_INLINE void f32_sin_n(f32 *TYPES_RESTRICT r, const f32 *TYPES_RESTRICT a, u32 count)
 {
-  return (double)x.high * 4294967296.0 + (double)x.low;
+  u32 i = 0;
+  u32 j;
+  for (; i + 16 <= count; i += 16)
+  {
+    f32 *TYPES_RESTRICT out = r + i;
+    const f32 *TYPES_RESTRICT in = a + i;
+    u32 large = 0;
+    for (j = 0; j < 16; ++j)
+    {
+      out[j] = types_f32_sin_quadrant(in[j], 0);
+      large |= (u32)types_f32_sin_is_large(in[j]);
+    }
+    /* Rare |x| >= 2^28: redo the block with the Payne-Hanek path */
+    if (large)
+    {
+      for (j = 0; j < 16; ++j)
+      {
+        out[j] = f32_sin(in[j]);
+      }
+    }
+  }
+  for (; i < count; ++i)
+  {
+    r[i] = f32_sin(a[i]);
+  }
 }
 
-TYPES_API TYPES_INLINE double double_from_i64(i64 x)
+TYPES_API TYPES_INLINE void f32_cos_n(f32 *TYPES_RESTRICT r, const f32 *TYPES_RESTRICT a, u32 count)
 {
-  u64 abs;
-  double d;
-
-  if (x.high < 0)
+  u32 i = 0;
+  u32 j;
+  for (; i + 16 <= count; i += 16)
   {
-    i64 neg = i64_neg(x);
-    abs.high = (u32)neg.high;
-    abs.low = neg.low;
-    d = double_from_u64(abs);
-    return -d;
+    f32 *TYPES_RESTRICT out = r + i;
+    const f32 *TYPES_RESTRICT in = a + i;
+    u32 large = 0;
+    for (j = 0; j < 16; ++j)
+    {
+      out[j] = types_f32_sin_quadrant(in[j], 1);
+      large |= (u32)types_f32_sin_is_large(in[j]);
+    }
+    /* Rare |x| >= 2^28: redo the block with the Payne-Hanek path */
+    if (large)
+    {
+      for (j = 0; j < 16; ++j)
+      {
+        out[j] = f32_cos(in[j]);
+      }
+    }
   }
-  else
+  for (; i < count; ++i)
   {
-    abs.high = (u32)x.high;
-    abs.low = x.low;
-    return double_from_u64(abs);
+    r[i] = f32_cos(a[i]);
   }
 }
 
-#endif /* C89 without long long */
-
 #endif /* TYPES_H */
 
 /*